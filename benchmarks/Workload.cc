@@ -0,0 +1,216 @@
+/*
+Workload.cc -- generate synthetic programs for benchmarks
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "Workload.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "Exception.h"
+
+namespace {
+
+void write_file(const std::filesystem::path& file_name, const std::string& contents) {
+    auto stream = std::ofstream(file_name, std::ios::binary);
+    stream << contents;
+    stream.close();
+    if (stream.fail()) {
+        throw Exception("can't write '%s'", file_name.c_str());
+    }
+}
+
+std::optional<std::string> argument_text(const AddressingMode::Argument* argument) {
+    auto stream = std::ostringstream();
+    switch (argument->type->type()) {
+        case ArgumentType::ANY:
+            return "loop";
+
+        case ArgumentType::ENCODING:
+            return "0";
+
+        case ArgumentType::ENUM: {
+            const auto& entries = dynamic_cast<const ArgumentTypeEnum*>(argument->type)->entries;
+            if (entries.empty()) {
+                return {};
+            }
+            auto names = std::vector<std::string>();
+            for (const auto& entry: entries) {
+                names.emplace_back(entry.first.str());
+            }
+            return *std::ranges::min_element(names);
+        }
+
+        case ArgumentType::MAP: {
+            const auto& entries = dynamic_cast<const ArgumentTypeMap*>(argument->type)->entries;
+            if (entries.empty()) {
+                return {};
+            }
+            auto values = std::vector<Value>();
+            for (const auto& entry: entries) {
+                values.emplace_back(entry.first);
+            }
+            stream << *std::ranges::min_element(values);
+            return stream.str();
+        }
+
+        case ArgumentType::RANGE:
+            stream << dynamic_cast<const ArgumentTypeRange*>(argument->type)->lower_bound;
+            return stream.str();
+    }
+
+    return {};
+}
+
+}
+
+std::vector<std::string> Workload::instructions(const CPU& cpu) {
+    auto lines = std::vector<std::string>();
+
+    for (const auto& [name, instruction]: cpu.all_instructions()) {
+        for (const auto& [addressing_mode_name, opcode]: instruction.opcodes) {
+            auto addressing_mode = cpu.addressing_mode(addressing_mode_name);
+            if (!addressing_mode || addressing_mode->notations.empty()) {
+                continue;
+            }
+            auto line = name.str();
+            auto ok = true;
+            for (const auto& element: addressing_mode->notations.front().elements) {
+                line += line.empty() ? "" : " ";
+                if (element.is_argument()) {
+                    auto argument = addressing_mode->argument(element.symbol);
+                    auto text = argument ? argument_text(argument) : std::nullopt;
+                    if (!text) {
+                        ok = false;
+                        break;
+                    }
+                    line += *text;
+                }
+                else {
+                    line += element.symbol.str();
+                }
+            }
+            if (ok && !line.empty()) {
+                lines.emplace_back(std::move(line));
+            }
+        }
+    }
+
+    std::ranges::sort(lines);
+    return lines;
+}
+
+void Workload::write(const std::filesystem::path& directory) const {
+    std::filesystem::create_directories(directory);
+
+    auto target = std::ostringstream();
+    target << ".cpu \"" << cpu << "\"\n";
+    target << "\n";
+    target << ".extension \"bin\"\n";
+    target << "\n";
+    target << ".section code {\n";
+    target << "    address: $0000 - $ffff\n";
+    target << "}\n";
+    target << "\n";
+    target << ".output {\n";
+    target << "    .memory .data_start, .data_end\n";
+    target << "}\n";
+    write_file(directory / "program.target", target.str());
+
+    auto random = std::mt19937_64(1);
+    auto data = std::string(binary_size, '\0');
+    std::ranges::generate(data, [&random]() {return static_cast<char>(random());});
+    write_file(directory / "data.bin", data);
+
+    auto instruction_lines = instructions(CPU::get(Symbol(cpu)));
+    auto source = std::ostringstream();
+    source << "; " << objects << " objects with " << instructions_per_object << " instructions each, " << macros << " macros, constant chain of depth " << constant_depth << ", .repeat of " << repeat_count << ", .binary_file of " << binary_size << " bytes\n";
+    source << "\n";
+    source << ".section code\n";
+    source << "\n";
+
+    // Define constants deepest first, so they can't be resolved in a single pass.
+    for (auto i = constant_depth; i > 0; i--) {
+        source << "constant_" << i << " = constant_" << i - 1 << " + 1\n";
+    }
+    source << "constant_0 = 0\n";
+    source << "\n";
+
+    for (size_t i = 0; i < macros; i++) {
+        source << ".macro macro_" << i << " value {\n";
+        source << "    .data value:1, value + " << i << ":2\n";
+        source << "}\n";
+        source << "\n";
+    }
+
+    for (size_t i = 0; i < objects; i++) {
+        source << ".use object_" << i << "\n";
+    }
+    if (repeat_count > 0) {
+        source << ".use table\n";
+    }
+    if (binary_size > 0) {
+        source << ".use blob\n";
+    }
+    source << "\n";
+
+    auto next_instruction = size_t{0};
+    for (size_t i = 0; i < objects; i++) {
+        source << "object_" << i << " {\n";
+        source << "loop:\n";
+        for (size_t j = 0; j < instructions_per_object && !instruction_lines.empty(); j++) {
+            source << "    " << instruction_lines[next_instruction] << "\n";
+            next_instruction = (next_instruction + 1) % instruction_lines.size();
+        }
+        if (macros > 0) {
+            source << "    macro_" << i % macros << " " << i % 256 << "\n";
+        }
+        source << "    .data constant_" << constant_depth << ":2\n";
+        source << "}\n";
+        source << "\n";
+    }
+
+    if (repeat_count > 0) {
+        source << "table {\n";
+        source << "    .repeat i, " << repeat_count << " {\n";
+        source << "        .data i:2\n";
+        source << "    }\n";
+        source << "}\n";
+        source << "\n";
+    }
+    if (binary_size > 0) {
+        source << "blob {\n";
+        source << "    .binary_file \"data.bin\"\n";
+        source << "}\n";
+    }
+    write_file(directory / "program.s", source.str());
+}
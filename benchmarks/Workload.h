@@ -0,0 +1,82 @@
+/*
+Workload.h -- generate synthetic programs for benchmarks
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "CPU.h"
+
+/**
+ * Synthetic program of configurable size, for measuring assembler and linker performance reproducibly.
+ *
+ * The program consists of objects containing instructions, macro invocations, and references to a chain of constants, plus one object with a large `.repeat` and one including a binary file.
+ */
+class Workload {
+  public:
+    /**
+     * Write the program, a target to link it with, and the binary file it includes.
+     *
+     * @param directory The directory to write `program.s`, `program.target`, and `data.bin` to.
+     * @throws Exception if the CPU can't be loaded or the files can't be written.
+     */
+    void write(const std::filesystem::path& directory) const;
+
+    /**
+     * Get one line for each combination of instruction and addressing mode of a CPU.
+     *
+     * Arguments that may be any value refer to the label `loop`, which must be defined nearby so that relative branches reach it.
+     *
+     * @param cpu The CPU to get instructions for.
+     * @return The instruction lines, sorted.
+     */
+    static std::vector<std::string> instructions(const CPU& cpu);
+
+    /// @brief The CPU to generate instructions for.
+    std::string cpu = "6502";
+    /// @brief Number of objects.
+    size_t objects = 500;
+    /// @brief Number of instructions per object.
+    size_t instructions_per_object = 16;
+    /// @brief Number of macros.
+    size_t macros = 50;
+    /// @brief Length of the chain of constants, each defined in terms of the previous one.
+    size_t constant_depth = 200;
+    /// @brief Number of iterations of the `.repeat`.
+    size_t repeat_count = 1000;
+    /// @brief Size of the included binary file in bytes.
+    size_t binary_size = 4096;
+};
+
+#endif // WORKLOAD_H
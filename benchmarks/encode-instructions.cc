@@ -0,0 +1,105 @@
+/*
+encode-instructions.cc -- benchmark assembling instructions of each CPU
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Assembler.h"
+#include "CPUGetter.h"
+#include "Exception.h"
+#include "FileReader.h"
+#include "Target.h"
+#include "TargetGetter.h"
+#include "Workload.h"
+
+int main(int argc, char* argv[]) {
+    const size_t count = 5;
+
+    auto system_path = Path();
+    const auto system_directory = getenv("XLR8_SYSTEM_DIRECTORY");
+    system_path.append_directory(system_directory ? system_directory : SOURCE_DIRECTORY "/share");
+    TargetGetter::global.path->append_path(system_path, "target");
+    CPUGetter::global.path->append_path(system_path, "cpu");
+
+    // Usage: encode-instructions [cpu ...], defaults to all CPUs with a target of their own.
+    auto cpus = std::vector<std::string>();
+    for (auto i = 1; i < argc; i++) {
+        cpus.emplace_back(argv[i]);
+    }
+    if (cpus.empty()) {
+        cpus = {"6502", "65c02", "4510", "45gs02", "z80", "z180", "z80n"};
+    }
+
+    try {
+        for (const auto& cpu: cpus) {
+            // Only instructions, so the time is spent parsing and encoding them.
+            auto workload = Workload();
+            workload.cpu = cpu;
+            workload.objects = 200;
+            workload.macros = 0;
+            workload.constant_depth = 0;
+            workload.repeat_count = 0;
+            workload.binary_size = 0;
+            auto directory = std::filesystem::temp_directory_path() / ("xlr8-encode-instructions-" + cpu);
+            workload.write(directory);
+
+            const auto& target = Target::get(Symbol((directory / "program.target").string()));
+            auto file_name = Symbol((directory / "program.s").string());
+            auto instructions = Workload::instructions(CPU::get(Symbol(cpu))).size();
+
+            auto start = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < count; i++) {
+                auto file = Assembler(&target, Path::empty_path, {}).parse_object_file(file_name);
+                if (!file || FileReader::global.had_error()) {
+                    throw Exception("can't assemble instructions for %s", cpu.c_str());
+                }
+            }
+
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+            printf("%-8s %4zu instructions, %zu objects in %zu passes, %" PRId64 " ms\n", cpu.c_str(), instructions, workload.objects, count, static_cast<int64_t>(duration.count() / 1000));
+
+            std::filesystem::remove_all(directory);
+        }
+    }
+    catch (Exception& ex) {
+        fprintf(stderr, "encode-instructions: %s\n", ex.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+environment-lookup.cc -- benchmark name lookup through a chain of environments
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Environment.h"
+
+int main() {
+    const size_t depth = 20;
+    const size_t symbols_per_level = 100;
+    const size_t count = 1000000;
+    auto random = std::mt19937_64(1);
+
+    // Build a chain like target, library, file, object, scope and macro environments: each level defines some names and continues in the one below.
+    auto names = std::vector<Symbol>();
+    auto environment = std::shared_ptr<Environment>();
+    for (size_t level = 0; level < depth; level++) {
+        auto new_environment = environment ? std::make_shared<Environment>(environment) : std::make_shared<Environment>();
+        for (size_t i = 0; i < symbols_per_level; i++) {
+            auto name = Symbol("symbol_" + std::to_string(level) + "_" + std::to_string(i));
+            new_environment->add(name, Expression({}, static_cast<uint64_t>(i)));
+            new_environment->add(name, SizeRange(i));
+            names.emplace_back(name);
+        }
+        environment = new_environment;
+    }
+    for (size_t i = 0; i < symbols_per_level; i++) {
+        names.emplace_back("undefined_" + std::to_string(i));
+    }
+
+    auto found = size_t{0};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < count; i++) {
+        // Favor names defined deep in the chain, like target and library symbols.
+        auto index = random() % 4 == 0 ? random() % names.size() : random() % (2 * symbols_per_level);
+        auto name = names[index];
+        if (i % 2 == 0) {
+            if ((*environment)[name]) {
+                found += 1;
+            }
+        }
+        else {
+            if (environment->get_label(name)) {
+                found += 1;
+            }
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("%zu lookups through %zu levels, %zu found, %" PRId64 " ms\n", count, depth, found, static_cast<int64_t>(duration.count() / 1000));
+
+    return 0;
+}
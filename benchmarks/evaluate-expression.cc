@@ -0,0 +1,108 @@
+/*
+evaluate-expression.cc -- benchmark evaluating expressions
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Environment.h"
+#include "EvaluationContext.h"
+#include "EvaluationResult.h"
+#include "Exception.h"
+#include "Expression.h"
+#include "ExpressionParser.h"
+#include "FileTokenizer.h"
+
+int main() {
+    const size_t variables = 100;
+    const size_t expressions = 1000;
+    const size_t count = 20;
+
+    auto environment = std::make_shared<Environment>();
+    for (size_t i = 0; i < variables; i++) {
+        environment->add(Symbol("variable_" + std::to_string(i)), Expression({}, static_cast<uint64_t>(i + 1)));
+    }
+
+    // Mix operators, constants, and variables, like address calculations and conditions in real sources.
+    auto text = std::string();
+    for (size_t i = 0; i < expressions; i++) {
+        auto a = "variable_" + std::to_string(i % variables);
+        auto b = "variable_" + std::to_string((i * 7 + 3) % variables);
+        auto c = "variable_" + std::to_string((i * 13 + 5) % variables);
+        if (i % 4 == 3) {
+            text += "(" + b + " > " + c + " && " + a + " != 0) || " + c + " == " + std::to_string(i % 10) + "\n";
+        }
+        else {
+            text += "(" + a + " * 3 + " + b + ") / " + c + " - (" + a + " << 2 | $" + std::to_string(i % 10) + "0) & $ffff\n";
+        }
+    }
+
+    try {
+        auto tokenizer = FileTokenizer();
+        ExpressionParser::setup(tokenizer);
+        tokenizer.push(Symbol("expressions"), Blob(text));
+
+        auto parsed = std::vector<Expression>();
+        while (true) {
+            tokenizer.skip(Token::NEWLINE);
+            if (tokenizer.ended() || !tokenizer.peek()) {
+                break;
+            }
+            parsed.emplace_back(tokenizer);
+        }
+
+        auto evaluated = size_t{0};
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < count; i++) {
+            for (const auto& expression: parsed) {
+                auto result = EvaluationResult();
+                auto new_expression = expression.evaluated(EvaluationContext(result, EvaluationContext::STANDALONE, environment));
+                if (new_expression && new_expression->has_value()) {
+                    evaluated += 1;
+                }
+            }
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        printf("%zu expressions evaluated in %zu passes, %" PRId64 " ms\n", evaluated, count, static_cast<int64_t>(duration.count() / 1000));
+    }
+    catch (Exception& ex) {
+        fprintf(stderr, "evaluate-expression: %s\n", ex.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+generate-program.cc -- generate synthetic program for benchmarks
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "CPUGetter.h"
+#include "Exception.h"
+#include "Workload.h"
+
+int main(int argc, char* argv[]) {
+    auto workload = Workload();
+    auto directory = std::string("workload");
+
+    auto system_path = Path();
+    const auto system_directory = getenv("XLR8_SYSTEM_DIRECTORY");
+    system_path.append_directory(system_directory ? system_directory : SOURCE_DIRECTORY "/share");
+    CPUGetter::global.path->append_path(system_path, "cpu");
+
+    // Usage: generate-program [directory [cpu [objects [macros [constant-depth [repeat-count [binary-size]]]]]]]
+    if (argc > 1) {
+        directory = argv[1];
+    }
+    if (argc > 2) {
+        workload.cpu = argv[2];
+    }
+    auto sizes = {&workload.objects, &workload.macros, &workload.constant_depth, &workload.repeat_count, &workload.binary_size};
+    auto index = 3;
+    for (auto size: sizes) {
+        if (argc > index) {
+            *size = std::strtoul(argv[index], nullptr, 10);
+        }
+        index += 1;
+    }
+
+    try {
+        workload.write(directory);
+    }
+    catch (Exception& ex) {
+        fprintf(stderr, "generate-program: %s\n", ex.what());
+        return 1;
+    }
+
+    return 0;
+}
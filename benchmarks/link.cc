@@ -0,0 +1,134 @@
+/*
+link.cc -- benchmark assembling and linking complete programs
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Assembler.h"
+#include "CPUGetter.h"
+#include "Exception.h"
+#include "FileReader.h"
+#include "LibraryGetter.h"
+#include "ProgramLinker.h"
+#include "Target.h"
+#include "TargetGetter.h"
+#include "Workload.h"
+
+namespace {
+
+void link(const std::filesystem::path& directory) {
+    const auto& target = Target::get(Symbol((directory / "program.target").string()));
+    auto include_path = Path();
+    include_path.append_directory(directory.string());
+
+    auto linker = ProgramLinker();
+    linker.set_target(&target);
+    auto file = Assembler(&target, include_path, {}).parse_object_file(Symbol((directory / "program.s").string()));
+    if (!file) {
+        throw Exception();
+    }
+    linker.add_file(file);
+    linker.link();
+    if (FileReader::global.had_error()) {
+        throw Exception();
+    }
+    linker.output((directory / "program.bin").string());
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const size_t count = 5;
+
+    auto system_path = Path();
+    const auto system_directory = getenv("XLR8_SYSTEM_DIRECTORY");
+    system_path.append_directory(system_directory ? system_directory : SOURCE_DIRECTORY "/share");
+    TargetGetter::global.path->append_path(system_path, "target");
+    CPUGetter::global.path->append_path(system_path, "cpu");
+    LibraryGetter::global.path->append_path(system_path, "lib");
+
+    // Usage: link [cpu [objects]]
+    auto workload = Workload();
+    if (argc > 1) {
+        workload.cpu = argv[1];
+    }
+    if (argc > 2) {
+        workload.objects = std::strtoul(argv[2], nullptr, 10);
+    }
+
+    auto directory = std::filesystem::temp_directory_path() / "xlr8-link";
+    try {
+        workload.write(directory);
+    }
+    catch (Exception& ex) {
+        fprintf(stderr, "link: %s\n", ex.what());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Each link runs in a fresh process, since targets and libraries keep state from linking.
+    for (size_t i = 0; i < count; i++) {
+        auto pid = fork();
+        if (pid == 0) {
+            try {
+                link(directory);
+                _exit(0);
+            }
+            catch (Exception& ex) {
+                if (!ex.empty()) {
+                    fprintf(stderr, "link: %s\n", ex.what());
+                }
+                _exit(1);
+            }
+        }
+        auto status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "link: linking failed\n");
+            return 1;
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("%zu objects for %s linked in %zu passes, %" PRId64 " ms\n", workload.objects, workload.cpu.c_str(), count, static_cast<int64_t>(duration.count() / 1000));
+
+    std::filesystem::remove_all(directory);
+
+    return 0;
+}
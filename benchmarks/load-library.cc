@@ -0,0 +1,113 @@
+/*
+load-library.cc -- benchmark loading libraries
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "Assembler.h"
+#include "BinaryObjectFile.h"
+#include "CPUGetter.h"
+#include "Exception.h"
+#include "FileReader.h"
+#include "LibraryLinker.h"
+#include "MappedFile.h"
+#include "ObjectFileParser.h"
+#include "Target.h"
+#include "TargetGetter.h"
+#include "Workload.h"
+
+int main(int argc, char* argv[]) {
+    const size_t count = 20;
+
+    auto system_path = Path();
+    const auto system_directory = getenv("XLR8_SYSTEM_DIRECTORY");
+    system_path.append_directory(system_directory ? system_directory : SOURCE_DIRECTORY "/share");
+    TargetGetter::global.path->append_path(system_path, "target");
+    CPUGetter::global.path->append_path(system_path, "cpu");
+
+    // Usage: load-library [objects]
+    auto workload = Workload();
+    if (argc > 1) {
+        workload.objects = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    auto directory = std::filesystem::temp_directory_path() / "xlr8-load-library";
+
+    try {
+        workload.write(directory);
+        const auto& target = Target::get(Symbol((directory / "program.target").string()));
+        auto include_path = Path();
+        include_path.append_directory(directory.string());
+        auto file = Assembler(&target, include_path, {}).parse_object_file(Symbol((directory / "program.s").string()));
+        if (!file) {
+            throw Exception();
+        }
+
+        for (auto binary: {false, true}) {
+            auto library_name = Symbol((directory / (binary ? "binary.lib" : "text.lib")).string());
+            auto linker = LibraryLinker();
+            linker.binary = binary;
+            linker.set_target(&target);
+            linker.add_file(file);
+            linker.link();
+            linker.output(library_name.str());
+
+            auto start = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < count; i++) {
+                if (binary) {
+                    BinaryObjectFile::read(library_name, std::make_shared<const MappedFile>(library_name));
+                }
+                else {
+                    ObjectFileParser().parse(library_name);
+                }
+            }
+
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+            printf("%-6s library with %zu objects loaded in %zu passes, %" PRId64 " ms\n", binary ? "binary" : "text", workload.objects, count, static_cast<int64_t>(duration.count() / 1000));
+        }
+    }
+    catch (Exception& ex) {
+        if (!ex.empty()) {
+            fprintf(stderr, "load-library: %s\n", ex.what());
+        }
+        return 1;
+    }
+
+    std::filesystem::remove_all(directory);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+memory-allocate.cc -- benchmark allocation of many objects in a memory bank
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <random>
+
+#include "Memory.h"
+
+int main() {
+    const size_t count = 100000;
+    auto bank = Memory::Bank(Range(0, 0x1000000));
+    auto random = std::mt19937_64(1);
+
+    auto allocated = size_t{0};
+    auto failed = size_t{0};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < count; i++) {
+        auto choice = random() % 100;
+        auto allocation = choice < 5 ? Memory::RESERVED : Memory::DATA;
+        auto size = choice < 60 ? 1 + random() % 16 : choice < 95 ? 1 + random() % 256 : 1 + random() % 4096;
+        auto alignment = choice % 10 == 0 ? 256 : choice % 10 == 1 ? 2 : 0;
+        auto result = std::optional<uint64_t>{};
+
+        if (choice < 2) {
+            // Fixed address, fragments the free space.
+            auto address = random() % 0x1000000;
+            result = bank.allocate(Range(address, size), allocation, 0, size);
+        }
+        else if (choice < 30) {
+            // Restricted to a section.
+            auto section_start = (random() % 16) * 0x100000;
+            result = bank.allocate(Range(section_start, 0x100000), allocation, alignment, size);
+        }
+        else {
+            result = bank.allocate(Range(0, 0x1000000), allocation, alignment, size);
+        }
+
+        if (result) {
+            allocated += 1;
+        }
+        else {
+            failed += 1;
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("%zu allocations, %zu failed, %" PRId64 " ms\n", allocated, failed, static_cast<int64_t>(duration.count() / 1000));
+
+    return 0;
+}
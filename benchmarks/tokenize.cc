@@ -0,0 +1,189 @@
+/*
+tokenize.cc -- benchmark tokenizing source files
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BodyParser.h"
+#include "CPUGetter.h"
+#include "Exception.h"
+#include "ExpressionParser.h"
+#include "FileReader.h"
+#include "FileTokenizer.h"
+#include "Target.h"
+#include "TargetGetter.h"
+
+namespace {
+
+class Input {
+public:
+    Symbol name;
+    std::optional<Blob> contents; // Read from name if not set.
+};
+
+class TestCase {
+public:
+    std::string name;
+    Symbol target;
+    std::vector<Input> inputs;
+};
+
+const size_t count = 200;
+
+// Read the target and the inline source files of a test case.
+TestCase read_test(const std::filesystem::path& file_name) {
+    auto test = TestCase{file_name.stem().string(), {}, {}};
+    auto stream = std::ifstream(file_name);
+    auto line = std::string();
+    while (std::getline(stream, line)) {
+        auto words = std::istringstream(line);
+        auto keyword = std::string();
+        words >> keyword;
+        if (keyword == "arguments") {
+            auto word = std::string();
+            while (words >> word) {
+                if (word == "--target" && words >> word) {
+                    test.target = Symbol(word);
+                }
+            }
+        }
+        else if (keyword == "file") {
+            auto name = std::string();
+            auto source = std::string();
+            words >> name >> source;
+            if (source != "<inline>" || !name.ends_with(".s")) {
+                continue;
+            }
+            auto contents = std::string();
+            while (std::getline(stream, line) && line != "end-of-inline-data") {
+                contents += line + "\n";
+            }
+            test.inputs.emplace_back(Symbol(name), Blob(std::move(contents)));
+        }
+    }
+    return test;
+}
+
+void run(const std::string& name, Symbol target_name, const std::vector<Input>& inputs) {
+    const auto& target = Target::get(target_name);
+    Target::set_current_target(&target);
+
+    // Like Assembler, compile the literals once and share them between the tokenizers of all source files.
+    auto setup_tokenizer = FileTokenizer();
+    target.cpu->setup(setup_tokenizer);
+    ExpressionParser::setup(setup_tokenizer);
+    BodyParser::setup(setup_tokenizer);
+    setup_tokenizer.add_punctuations({"{", "}", "=", ":"});
+    const auto literals = setup_tokenizer.literals();
+
+    auto tokens = size_t{0};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < count; i++) {
+        auto tokenizer = FileTokenizer(Path::empty_path, &target);
+        tokenizer.set_literals(literals);
+        for (auto input = inputs.rbegin(); input != inputs.rend(); input++) {
+            if (input->contents) {
+                tokenizer.push(input->name, *input->contents);
+            }
+            else {
+                tokenizer.push(input->name);
+            }
+        }
+
+        while (!tokenizer.ended()) {
+            tokenizer.next();
+            tokens += 1;
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("%s: %zu tokens in %zu passes, %" PRId64 " us per pass\n", name.c_str(), tokens, count, static_cast<int64_t>(duration.count()) / static_cast<int64_t>(count));
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto system_path = Path();
+    const auto system_directory = getenv("XLR8_SYSTEM_DIRECTORY");
+    system_path.append_directory(system_directory ? system_directory : SOURCE_DIRECTORY "/share");
+    TargetGetter::global.path->append_path(system_path, "target");
+    CPUGetter::global.path->append_path(system_path, "cpu");
+
+    try {
+        // Usage: tokenize --cpu-tests, tokenizes the sources of tests/cpu-NAME.test for target NAME.
+        if (argc > 1 && std::string(argv[1]) == "--cpu-tests") {
+            auto tests = std::vector<TestCase>();
+            for (const auto& entry: std::filesystem::directory_iterator(SOURCE_DIRECTORY "/tests")) {
+                if (entry.path().extension() != ".test") {
+                    continue;
+                }
+                auto test = read_test(entry.path());
+                if (test.name == "cpu-" + test.target.str() && !test.inputs.empty()) {
+                    tests.emplace_back(std::move(test));
+                }
+            }
+            std::ranges::sort(tests, [](const TestCase& a, const TestCase& b) {return a.name < b.name;});
+            for (const auto& test: tests) {
+                run(test.name, test.target, test.inputs);
+            }
+            return 0;
+        }
+
+        // Usage: tokenize [target [file ...]], defaults to the F256 library.
+        auto target_name = Symbol(argc > 1 ? argv[1] : "f256");
+        auto inputs = std::vector<Input>();
+        for (auto i = 2; i < argc; i++) {
+            inputs.emplace_back(Symbol(argv[i]));
+        }
+        if (inputs.empty()) {
+            inputs.emplace_back(Symbol(std::string(system_directory ? system_directory : SOURCE_DIRECTORY "/share") + "/lib/f256.s"));
+        }
+        run(target_name.str(), target_name, inputs);
+    }
+    catch (Exception& ex) {
+        fprintf(stderr, "tokenize: %s\n", ex.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -41,3 +41,37 @@ const AddressingMode::Argument* AddressingMode::argument(Symbol name) const {
         return it->second.get();
     }
 }
+
+void AddressingMode::resolve_arguments() {
+    for (auto& notation: notations) {
+        notation.arguments.clear();
+        for (size_t position = 0; position < notation.elements.size(); position++) {
+            const auto& element = notation.elements[position];
+            if (!element.is_argument()) {
+                continue;
+            }
+            auto argument_type = argument(element.symbol)->type;
+            auto& resolved = notation.arguments.emplace_back(position, element.symbol, argument_type->type());
+            switch (resolved.type) {
+                case ArgumentType::ANY:
+                case ArgumentType::ENCODING:
+                    break;
+
+                case ArgumentType::ENUM:
+                    resolved.enum_type = dynamic_cast<const ArgumentTypeEnum*>(argument_type);
+                    break;
+
+                case ArgumentType::MAP:
+                    resolved.map_type = dynamic_cast<const ArgumentTypeMap*>(argument_type);
+                    break;
+
+                case ArgumentType::RANGE:
+                    resolved.range_type = dynamic_cast<const ArgumentTypeRange*>(argument_type);
+                    break;
+            }
+            if (encoding_template) {
+                resolved.template_index = encoding_template->argument_index(element.symbol);
+            }
+        }
+    }
+}
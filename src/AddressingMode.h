@@ -35,6 +35,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <utility>
 
 #include "ArgumentType.h"
+#include "EncodingTemplate.h"
 #include "ParsedValue.h"
 #include "Symbol.h"
 
@@ -57,7 +58,20 @@ public:
             Symbol symbol;
         };
 
+        // Argument of a notation, resolved by resolve_arguments().
+        class ResolvedArgument {
+        public:
+            size_t position; // Index of the element in the notation.
+            Symbol name;
+            ArgumentType::Type type;
+            const ArgumentTypeEnum* enum_type{};
+            const ArgumentTypeMap* map_type{};
+            const ArgumentTypeRange* range_type{};
+            std::optional<size_t> template_index; // Index in the encoding template's arguments.
+        };
+
         std::vector<Element> elements;
+        std::vector<ResolvedArgument> arguments;
     };
 
     class Argument {
@@ -74,11 +88,15 @@ public:
 
     bool operator<(const AddressingMode& other) const {return priority < other.priority;}
 
+    // Resolve the arguments of all notations. Must be called once arguments and encoding template are final.
+    void resolve_arguments();
+
     size_t priority = std::numeric_limits<size_t>::max();
     bool uses_pc = false;
     std::vector<Notation> notations;
     std::unordered_map<Symbol, std::unique_ptr<Argument>> arguments;
     Body encoding;
+    std::optional<EncodingTemplate> encoding_template; // Used to encode instructions with constant arguments.
 
     void add_notation(Notation notation) {notations.emplace_back(std::move(notation));}
 };
@@ -30,40 +30,57 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AddressingModeMatcher.h"
+
+#include <algorithm>
+
 #include "ParseException.h"
 #include "TokenNode.h"
 
+const std::vector<AddressingModeMatcherResult> AddressingModeMatcher::no_results;
+
 void AddressingModeMatcher::add_notation(Symbol addressing_mode, size_t notation_index, const AddressingMode::Notation &notation, const std::unordered_map<Symbol, std::unique_ptr<AddressingMode::Argument>>& arguments) {
-    start.add_notation(AddressingModeMatcherResult(addressing_mode, notation_index), notation.elements.begin(), notation.elements.end(), arguments);
+    add_notation(0, AddressingModeMatcherResult(addressing_mode, notation_index), notation.elements.begin(), notation.elements.end(), arguments);
 }
 
-void AddressingModeMatcher::MatcherNode::add_notation(const AddressingModeMatcherResult& result, std::vector<AddressingMode::Notation::Element>::const_iterator current, std::vector<AddressingMode::Notation::Element>::const_iterator end, const std::unordered_map<Symbol, std::unique_ptr<AddressingMode::Argument>>& arguments) { // NOLINT(misc-no-recursion)
+void AddressingModeMatcher::add_notation(size_t node_index, const AddressingModeMatcherResult& result, std::vector<AddressingMode::Notation::Element>::const_iterator current, std::vector<AddressingMode::Notation::Element>::const_iterator end, const std::unordered_map<Symbol, std::unique_ptr<AddressingMode::Argument>>& arguments) { // NOLINT(misc-no-recursion)
     if (current == end) {
-        results.insert(result);
+        auto& results = nodes[node_index].results;
+        if (std::ranges::find(results, result) == results.end()) {
+            results.emplace_back(result);
+        }
         return;
     }
     for (const auto& element: AddressingModeMatcherElement::elements_for(*current, arguments)) {
-        if (!next.contains(element)) {
-            next[element] = std::make_unique<MatcherNode>();
+        auto next_index = nodes[node_index].next(element);
+        if (!next_index) {
+            next_index = nodes.size();
+            nodes.emplace_back();
+            nodes[node_index].transitions.emplace_back(element, *next_index);
         }
-        next[element]->add_notation(result, current + 1, end, arguments);
+        add_notation(*next_index, result, current + 1, end, arguments);
     }
 }
 
-std::unordered_set<AddressingModeMatcherResult> AddressingModeMatcher::match(const std::vector<std::shared_ptr<Node>>& nodes) const {
-    auto current = nodes.begin();
-
-    const MatcherNode* node = &start;
-    while (current != nodes.end()) {
-        auto it = node->next.find(AddressingModeMatcherElement(current->get()));
-        if (it == node->next.end()) {
-            return {};
+const std::vector<AddressingModeMatcherResult>& AddressingModeMatcher::match(const std::vector<std::shared_ptr<Node>>& arguments) const {
+    size_t node_index = 0;
+    for (const auto& argument: arguments) {
+        auto next_index = nodes[node_index].next(AddressingModeMatcherElement(argument.get()));
+        if (!next_index) {
+            return no_results;
         }
-        ++current;
-        node = it->second.get();
+        node_index = *next_index;
     }
 
-    return node->results;
+    return nodes[node_index].results;
+}
+
+std::optional<size_t> AddressingModeMatcher::MatcherNode::next(const AddressingModeMatcherElement& element) const {
+    for (const auto& [transition_element, next_index]: transitions) {
+        if (transition_element == element) {
+            return next_index;
+        }
+    }
+    return {};
 }
 
 
@@ -125,7 +142,7 @@ AddressingModeMatcherElement::elements_for(const AddressingMode::Notation::Eleme
     return elements;
 }
 
-AddressingModeMatcherElement::AddressingModeMatcherElement(Node *node) {
+AddressingModeMatcherElement::AddressingModeMatcherElement(const Node *node) {
     switch (node->type()) {
         case Node::EXPRESSION:
             type = INTEGER;
@@ -133,12 +150,12 @@ AddressingModeMatcherElement::AddressingModeMatcherElement(Node *node) {
 
         case Node::PUNCTUATION:
             type = PUNCTUATION;
-            symbol = dynamic_cast<TokenNode*>(node)->as_symbol();
+            symbol = static_cast<const TokenNode*>(node)->as_symbol();
             break;
 
         case Node::KEYWORD:
             type = KEYWORD;
-            symbol = dynamic_cast<TokenNode*>(node)->as_symbol();
+            symbol = static_cast<const TokenNode*>(node)->as_symbol();
             break;
     }
 }
@@ -32,8 +32,10 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ADDRESSING_MODE_MATCHER_H
 #define ADDRESSING_MODE_MATCHER_H
 
+#include <optional>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Node.h"
 #include "Symbol.h"
@@ -49,7 +51,7 @@ public:
 
     AddressingModeMatcherElement(Type type, Symbol symbol): type(type), symbol(symbol) {}
     AddressingModeMatcherElement(): type(INTEGER) {}
-    explicit AddressingModeMatcherElement(Node* node);
+    explicit AddressingModeMatcherElement(const Node* node);
 
     bool operator==(const AddressingModeMatcherElement& other) const;
 
@@ -60,26 +62,6 @@ public:
 };
 
 
-template<>
-struct std::hash<AddressingModeMatcherElement>
-{
-    std::size_t operator()(AddressingModeMatcherElement const& element) const noexcept {
-        size_t h1 = std::hash<size_t>{}(static_cast<size_t>(element.type));
-        size_t h2 = 0;
-        switch (element.type) {
-            case AddressingModeMatcherElement::INTEGER:
-                break;
-
-            case AddressingModeMatcherElement::KEYWORD:
-            case AddressingModeMatcherElement::PUNCTUATION:
-                h2 = std::hash<Symbol>{}(element.symbol);
-                break;
-        }
-        return h1 ^ (h2 << 1);
-    }
-};
-
-
 class AddressingModeMatcherResult {
 public:
     AddressingModeMatcherResult(Symbol addressing_mode, size_t notation_index): addressing_mode(addressing_mode), notation_index(notation_index) {}
@@ -90,31 +72,28 @@ public:
 };
 
 
-template<>
-struct std::hash<AddressingModeMatcherResult>
-{
-    std::size_t operator()(AddressingModeMatcherResult const& result) const noexcept {
-        return std::hash<Symbol>{}(result.addressing_mode) ^ (std::hash<size_t>{}(result.notation_index) << 1);
-    }
-};
-
-
 class AddressingModeMatcher {
 public:
-    [[nodiscard]] std::unordered_set<AddressingModeMatcherResult> match(const std::vector<std::shared_ptr<Node>>& nodes) const;
+    // Results are ordered by addressing mode priority, then notation index. The returned reference stays valid as long as the matcher.
+    [[nodiscard]] const std::vector<AddressingModeMatcherResult>& match(const std::vector<std::shared_ptr<Node>>& nodes) const;
 
+    // Addressing modes must be added in order of priority.
     void add_notation(Symbol addressing_mode, size_t notation_index, const AddressingMode::Notation& notation, const std::unordered_map<Symbol, std::unique_ptr<AddressingMode::Argument>>& arguments);
 
 private:
     class MatcherNode {
     public:
-        void add_notation(const AddressingModeMatcherResult& result, std::vector<AddressingMode::Notation::Element>::const_iterator current, std::vector<AddressingMode::Notation::Element>::const_iterator end, const std::unordered_map<Symbol, std::unique_ptr<AddressingMode::Argument>>& arguments);
+        [[nodiscard]] std::optional<size_t> next(const AddressingModeMatcherElement& element) const;
 
-        std::unordered_set<AddressingModeMatcherResult> results;
-        std::unordered_map<AddressingModeMatcherElement, std::unique_ptr<MatcherNode>> next;
+        std::vector<AddressingModeMatcherResult> results;
+        std::vector<std::pair<AddressingModeMatcherElement, size_t>> transitions; // Indices into nodes, few enough per node to search linearly.
     };
 
-    MatcherNode start;
+    void add_notation(size_t node_index, const AddressingModeMatcherResult& result, std::vector<AddressingMode::Notation::Element>::const_iterator current, std::vector<AddressingMode::Notation::Element>::const_iterator end, const std::unordered_map<Symbol, std::unique_ptr<AddressingMode::Argument>>& arguments);
+
+    std::vector<MatcherNode> nodes = std::vector<MatcherNode>(1); // First node is the start node.
+
+    static const std::vector<AddressingModeMatcherResult> no_results;
 };
 
 
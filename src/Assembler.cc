@@ -86,6 +86,9 @@ const std::unordered_map<Token, Assembler::Directive> Assembler::directives = {
 };
 // clang-format on
 
+std::mutex Assembler::source_literals_mutex;
+std::unordered_map<const CPU*, std::shared_ptr<const FileTokenizer::Literals>> Assembler::source_literals_cache;
+
 Assembler::Assembler(const Target* target, const Path& path, const std::unordered_set<Symbol>& defines) : tokenizer{path, target, true, defines} { set_target(target); }
 
 Target Assembler::parse_target(Symbol name, Symbol file_name) {
@@ -114,13 +117,16 @@ std::shared_ptr<ObjectFile> Assembler::parse_object_file(Symbol file_name) {
 void Assembler::parse(Symbol file_name) {
     if (target) {
         Target::set_current_target(target);
-        target->cpu->setup(tokenizer);
         cpu = target->cpu;
         tokenizer.define(target->defines);
     }
-    ExpressionParser::setup(tokenizer);
-    BodyParser::setup(tokenizer);
-    tokenizer.add_punctuations({"{", "}", "=", ":"});
+    if (parsing_target) {
+        setup_literals(tokenizer, cpu);
+    }
+    else {
+        // All source files for a CPU use the same literals, so they are compiled only once.
+        tokenizer.set_literals(source_literals(cpu));
+    }
     tokenizer.push(file_name);
 
     object_file->target = target;
@@ -496,6 +502,26 @@ void Assembler::parse_visibility(const Token& directive) {
     }
 }
 
+void Assembler::setup_literals(FileTokenizer& tokenizer, const CPU* cpu) {
+    if (cpu) {
+        cpu->setup(tokenizer);
+    }
+    ExpressionParser::setup(tokenizer);
+    BodyParser::setup(tokenizer);
+    tokenizer.add_punctuations({"{", "}", "=", ":"});
+}
+
+std::shared_ptr<const FileTokenizer::Literals> Assembler::source_literals(const CPU* cpu) {
+    auto lock = std::lock_guard(source_literals_mutex);
+    auto& literals = source_literals_cache[cpu];
+    if (!literals) {
+        auto tokenizer = FileTokenizer();
+        setup_literals(tokenizer, cpu);
+        literals = tokenizer.literals();
+    }
+    return literals;
+}
+
 void Assembler::set_target(const Target* new_target) {
     // TODO: check that target and new_target are compatible
     target = new_target;
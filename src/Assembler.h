@@ -32,6 +32,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSEMBLER_H
 #define ASSEMBLER_H
 
+#include <mutex>
+
 #include "ObjectFile.h"
 #include "Target.h"
 #include "FileTokenizer.h"
@@ -84,6 +86,9 @@ private:
     void parse_visibility(const Token& directive);
     void set_target(const Target* new_target);
 
+    static void setup_literals(FileTokenizer& tokenizer, const CPU* cpu);
+    static std::shared_ptr<const FileTokenizer::Literals> source_literals(const CPU* cpu);
+
     std::vector<MemoryMap::Block> parse_address(const ParsedValue* address) const;
     MemoryMap::Block parse_single_address(const ParsedScalar* address) const;
     uint64_t parse_address_part(const Token& token) const;
@@ -131,6 +136,9 @@ private:
     static const Token token_uses;
     static const Token token_visibility;
     static const std::unordered_map<Token, Directive> directives;
+
+    static std::mutex source_literals_mutex;
+    static std::unordered_map<const CPU*, std::shared_ptr<const FileTokenizer::Literals>> source_literals_cache;
 };
 
 #endif // ASSEMBLER_H
@@ -41,7 +41,7 @@ public:
 
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<AssignmentBody>(visibility, name, value);}
     [[nodiscard]] bool empty() const override {return false;}
-    void encode(std::string &bytes, const Memory *memory) const override {return;}
+    void encode(ByteSink& bytes, const Memory *memory) const override {return;}
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext &context) const override;
     void serialize(std::ostream &stream, const std::string &prefix) const override;
 
@@ -32,6 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef BASEENCODER_H
 #define BASEENCODER_H
 
+#include "ByteSink.h"
 #include "SizeRange.h"
 
 class Encoder;
@@ -40,7 +41,7 @@ class BaseEncoder {
 public:
     virtual ~BaseEncoder() = default;
 
-    virtual void encode(std::string& bytes, const Value& value) const = 0;
+    virtual void encode(ByteSink& bytes, const Value& value) const = 0;
     [[nodiscard]] virtual size_t encoded_size(const Value& value) const = 0;
     [[nodiscard]] virtual bool fits(const Value& value) const = 0;
     [[nodiscard]] virtual bool is_natural_encoder(const Value& value) const = 0;
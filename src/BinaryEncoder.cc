@@ -33,8 +33,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Encoder.h"
 
-void BinaryEncoder::encode(std::string& bytes, const Value& value) const {
-    bytes += value.binary_value();
+void BinaryEncoder::encode(ByteSink& bytes, const Value& value) const {
+    bytes.append(value.binary_value());
 }
 
 size_t BinaryEncoder::encoded_size(const Value& value) const { return value.binary_value().size(); }
@@ -37,7 +37,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 class BinaryEncoder: public BaseEncoder {
 public:
-    void encode(std::string& bytes, const Value& value) const override;
+    void encode(ByteSink& bytes, const Value& value) const override;
     [[nodiscard]] size_t encoded_size(const Value& value) const override;
     [[nodiscard]] bool fits(const Value& value) const override {return value.is_binary();}
     [[nodiscard]] bool is_natural_encoder(const Value& value) const override {return value.is_binary();}
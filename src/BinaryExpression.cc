@@ -125,88 +125,90 @@ void BinaryExpression::serialize_sub(std::ostream& stream) const {
     stream << right << ')';
 }
 
-Expression BinaryExpression::create(const Location& location, const Expression& left, Expression::BinaryOperation operation, const Expression& right) {
-    // TODO: check that types are compatible
+Value BinaryExpression::evaluate(const Value& left, Expression::BinaryOperation operation, const Value& right) {
+    Value value;
 
-    if (left.has_value() && right.has_value()) {
-        auto left_value = *left.value();
-        auto right_value = *right.value();
-        Value value;
+    switch (operation) {
+        case Expression::BinaryOperation::ADD:
+            value = left + right;
+            break;
 
-        switch (operation) {
-            case Expression::BinaryOperation::ADD:
-                value = left_value + right_value;
-                break;
+        case Expression::BinaryOperation::SUBTRACT:
+            value = left - right;
+            break;
 
-            case Expression::BinaryOperation::SUBTRACT:
-                value = left_value - right_value;
-                break;
+        case Expression::BinaryOperation::SHIFT_RIGHT:
+            value = left >> right;
+            break;
 
-            case Expression::BinaryOperation::SHIFT_RIGHT:
-                value = left_value >> right_value;
-                break;
+        case Expression::BinaryOperation::SHIFT_LEFT:
+            value = left << right;
+            break;
 
-            case Expression::BinaryOperation::SHIFT_LEFT:
-                value = left_value << right_value;
-                break;
+        case Expression::BinaryOperation::BITWISE_XOR:
+            value = left ^ right;
+            break;
 
-            case Expression::BinaryOperation::BITWISE_XOR:
-                value = left_value ^ right_value;
-                break;
+        case Expression::BinaryOperation::BITWISE_AND:
+            value = left & right;
+            break;
 
-            case Expression::BinaryOperation::BITWISE_AND:
-                value = left_value & right_value;
-                break;
+        case Expression::BinaryOperation::BITWISE_OR:
+            value = left | right;
+            break;
 
-            case Expression::BinaryOperation::BITWISE_OR:
-                value = left_value | right_value;
-                break;
+        case Expression::BinaryOperation::LOGICAL_AND:
+            value = left && right;
+            break;
 
-            case Expression::BinaryOperation::LOGICAL_AND:
-                value = left_value && right_value;
-                break;
+        case Expression::BinaryOperation::LOGICAL_OR:
+            value = left || right;
+            break;
 
-            case Expression::BinaryOperation::LOGICAL_OR:
-                value = left_value || right_value;
-                break;
+        case Expression::BinaryOperation::MULTIPLY:
+            value = left * right;
+            break;
 
-            case Expression::BinaryOperation::MULTIPLY:
-                value = left_value * right_value;
-                break;
+        case Expression::BinaryOperation::DIVIDE:
+            value = left / right;
+            break;
 
-            case Expression::BinaryOperation::DIVIDE:
-                value = left_value / right_value;
-                break;
+        case Expression::BinaryOperation::MODULO:
+            value = left % right;
+            break;
+        case Expression::EQUAL:
+            value = Value(left == right);
+            break;
 
-            case Expression::BinaryOperation::MODULO:
-                value = left_value % right_value;
-                break;
-            case Expression::EQUAL:
-                value = Value(left_value == right_value);
-                break;
+        case Expression::GREATER:
+            value = Value(left > right);
+            break;
 
-            case Expression::GREATER:
-                value = Value(left_value > right_value);
-                break;
+        case Expression::GREATER_EQUAL:
+            value = Value(left >= right);
+            break;
 
-            case Expression::GREATER_EQUAL:
-                value = Value(left_value >= right_value);
-                break;
+        case Expression::LESS:
+            value = Value(left < right);
+            break;
 
-            case Expression::LESS:
-                value = Value(left_value < right_value);
-                break;
+        case Expression::LESS_EQUAL:
+            value = Value(left <= right);
+            break;
 
-            case Expression::LESS_EQUAL:
-                value = Value(left_value <= right_value);
-                break;
+        case Expression::NOT_EQUAL:
+            value = Value(left != right);
+            break;
+    }
 
-            case Expression::NOT_EQUAL:
-                value = Value(left_value != right_value);
-                break;
-        }
+    return value;
+}
 
-        return Expression(location, value);
+Expression BinaryExpression::create(const Location& location, const Expression& left, Expression::BinaryOperation operation, const Expression& right) {
+    // TODO: check that types are compatible
+
+    if (left.has_value() && right.has_value()) {
+        return Expression(location, evaluate(*left.value(), operation, *right.value()));
     }
     else {
         switch (operation) {
@@ -50,6 +50,16 @@ public:
      */
     BinaryExpression(const Location& location, Expression left, Expression::BinaryOperation operation, Expression right): BaseExpression(location), left(std::move(left)), operation(operation), right(std::move(right)) {}
 
+    /**
+     * Apply a binary operation to two values.
+     *
+     * @param left The left operand.
+     * @param operation The binary operation.
+     * @param right The right operand.
+     * @return The result of the operation.
+     */
+    [[nodiscard]] static Value evaluate(const Value& left, Expression::BinaryOperation operation, const Value& right);
+
     [[nodiscard]] std::optional<Value> minimum_value() const override;
     [[nodiscard]] std::optional<Value> maximum_value() const override;
     [[nodiscard]] std::optional<Value::Type> type() const override;
@@ -75,6 +85,8 @@ protected:
 
     void serialize_sub(std::ostream& stream) const override;
 
+    friend class EncodingTemplate;
+    friend class ExpressionTemplate;
     friend class Expression;
 
 private:
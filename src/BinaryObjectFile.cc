@@ -0,0 +1,416 @@
+/*
+BinaryObjectFile.cc -- precompiled library format
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "BinaryObjectFile.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "Exception.h"
+#include "ObjectFile.h"
+
+const unsigned int BinaryObjectFile::format_version_major = 2;
+const unsigned int BinaryObjectFile::format_version_minor = 0;
+
+BinaryObjectFile::BinaryObjectFile(Symbol file_name, std::shared_ptr<const MappedFile> file_): file_name{file_name}, file{std::move(file_)} {
+    auto reader = Reader(*this, header().size());
+
+    auto symbol_count = reader.varint();
+    symbols.reserve(symbol_count);
+    for (uint64_t i = 0; i < symbol_count; i++) {
+        auto length = reader.varint();
+        symbols.emplace_back(std::string(reader.bytes(length)));
+    }
+
+    auto section_count = reader.varint();
+    sections.reserve(section_count);
+    for (uint64_t i = 0; i < section_count; i++) {
+        auto directive = reader.symbol();
+        auto name = reader.symbol();
+        auto offset = reader.varint();
+        sections.emplace_back(directive, name, offset);
+        sections.back().count = reader.varint();
+    }
+
+    auto data_size = reader.varint();
+    auto data_offset = file->size() - data_size;
+    (void)reader.bytes(data_size);
+    for (auto& section: sections) {
+        if (section.offset > data_size) {
+            throw Exception("invalid section offset in '%s'", file_name.c_str());
+        }
+        section.offset += data_offset;
+    }
+}
+
+
+std::shared_ptr<ObjectFile> BinaryObjectFile::read(Symbol file_name, std::shared_ptr<const MappedFile> file) {
+    auto object_file = std::make_shared<ObjectFile>();
+    object_file->name = file_name;
+
+    auto binary_file = std::make_shared<BinaryObjectFile>(file_name, std::move(file));
+    binary_file->object_file = object_file;
+
+    for (size_t index = 0; index < binary_file->sections.size(); index++) {
+        const auto& section = binary_file->sections[index];
+        if (is_entity(section.directive)) {
+            binary_file->pending[section.name].emplace_back(index);
+        }
+        else {
+            binary_file->parser.parse(object_file, binary_file->tokens(section));
+        }
+    }
+
+    object_file->set_source(std::move(binary_file));
+    return object_file;
+}
+
+
+void BinaryObjectFile::write(std::ostream& stream, const ObjectFile& file, Symbol file_name) {
+    auto text = std::stringstream{};
+    text << file;
+    auto tokens = ObjectFileParser().tokenize(file_name, Blob(text.str()));
+
+    auto symbol_indices = std::unordered_map<Symbol, size_t>{};
+    auto new_sections = std::vector<Section>{};
+    auto data = std::stringstream{};
+    auto data_writer = Writer(data);
+    auto skipping = false;
+
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const auto& token = tokens[i];
+
+        // Top level directives start at the beginning of a line, everything nested is indented.
+        if (token.is_directive() && token.location.start_column == 0 && (i == 0 || tokens[i - 1].is_newline())) {
+            skipping = token == ObjectFileParser::token_format_version;
+            if (!skipping) {
+                auto name = is_entity(token.as_symbol()) && i + 1 < tokens.size() ? tokens[i + 1].as_symbol() : Symbol();
+                new_sections.emplace_back(token.as_symbol(), name, static_cast<size_t>(data.tellp()));
+            }
+        }
+        if (skipping || new_sections.empty()) {
+            continue;
+        }
+
+        data_writer.token(token, symbol_indices);
+        new_sections.back().count += 1;
+    }
+
+    for (const auto& section: new_sections) {
+        symbol_indices.insert({section.directive, symbol_indices.size()});
+        if (!section.name.empty()) {
+            symbol_indices.insert({section.name, symbol_indices.size()});
+        }
+    }
+
+    auto sorted_symbols = std::vector<Symbol>(symbol_indices.size());
+    for (const auto& [symbol, index]: symbol_indices) {
+        sorted_symbols[index] = symbol;
+    }
+
+    auto writer = Writer(stream);
+    writer.bytes(header());
+    writer.varint(sorted_symbols.size());
+    for (const auto& symbol: sorted_symbols) {
+        writer.varint(symbol.str().size());
+        writer.bytes(symbol.str());
+    }
+    writer.varint(new_sections.size());
+    for (const auto& section: new_sections) {
+        writer.varint(symbol_indices[section.directive] + 1);
+        writer.varint(section.name.empty() ? 0 : symbol_indices[section.name] + 1);
+        writer.varint(section.offset);
+        writer.varint(section.count);
+    }
+    auto data_string = data.str();
+    writer.varint(data_string.size());
+    writer.bytes(data_string);
+}
+
+
+bool BinaryObjectFile::materialize(Symbol name) {
+    auto it = pending.find(name);
+    if (it == pending.end()) {
+        return false;
+    }
+
+    auto indices = std::move(it->second);
+    pending.erase(it);
+
+    auto owner = object_file.lock();
+    for (auto index: indices) {
+        parser.parse(owner, tokens(sections[index]));
+    }
+    return true;
+}
+
+
+void BinaryObjectFile::materialize_all(Symbol directive) {
+    auto names = std::vector<Symbol>{};
+    for (const auto& [name, indices]: pending) {
+        for (auto index: indices) {
+            if (sections[index].directive == directive) {
+                names.emplace_back(name);
+                break;
+            }
+        }
+    }
+
+    for (auto name: names) {
+        materialize(name);
+    }
+}
+
+
+const std::string& BinaryObjectFile::header() {
+    static const auto header = ".format_version " + std::to_string(format_version_major) + "." + std::to_string(format_version_minor) + "\n";
+    return header;
+}
+
+
+bool BinaryObjectFile::is_entity(Symbol directive) {
+    return directive == ObjectFileParser::token_constant.as_symbol() || directive == ObjectFileParser::token_function.as_symbol() || directive == ObjectFileParser::token_macro.as_symbol() || directive == ObjectFileParser::token_object.as_symbol();
+}
+
+
+std::vector<Token> BinaryObjectFile::tokens(const Section& section) const {
+    auto reader = Reader(*this, section.offset);
+    auto section_tokens = std::vector<Token>{};
+
+    section_tokens.reserve(section.count);
+    for (size_t i = 0; i < section.count; i++) {
+        section_tokens.emplace_back(reader.token());
+    }
+
+    return section_tokens;
+}
+
+
+BinaryObjectFile::Reader::Reader(const BinaryObjectFile& file, size_t offset): file{file}, current{file.file->data() + offset}, end{file.file->data() + file.file->size()} {}
+
+
+uint8_t BinaryObjectFile::Reader::byte() {
+    if (current == end) {
+        throw Exception("unexpected end of binary library '%s'", file.file_name.c_str());
+    }
+    return static_cast<uint8_t>(*(current++));
+}
+
+
+std::string_view BinaryObjectFile::Reader::bytes(size_t length) {
+    if (static_cast<size_t>(end - current) < length) {
+        throw Exception("unexpected end of binary library '%s'", file.file_name.c_str());
+    }
+    auto value = std::string_view(current, length);
+    current += length;
+    return value;
+}
+
+
+Symbol BinaryObjectFile::Reader::symbol() {
+    auto index = varint();
+    if (index == 0) {
+        return {};
+    }
+    if (index > file.symbols.size()) {
+        throw Exception("invalid symbol in binary library '%s'", file.file_name.c_str());
+    }
+    return file.symbols[index - 1];
+}
+
+
+Token BinaryObjectFile::Reader::token() {
+    auto type = static_cast<Token::Type>(byte());
+    auto location = Location();
+    location.file = file.file_name;
+    location.start_line_number = varint();
+    location.start_column = varint();
+    location.end_column = varint();
+
+    switch (type) {
+        case Token::DIRECTIVE:
+        case Token::INSTRUCTION:
+        case Token::KEYWORD:
+        case Token::NAME:
+        case Token::PREPROCESSOR:
+        case Token::PUNCTUATION:
+        case Token::STRING:
+            return {type, location, symbol()};
+
+        case Token::END:
+        case Token::NEWLINE:
+            return {type, location};
+
+        case Token::VALUE:
+            switch (static_cast<Value::Type>(byte())) {
+                case Value::BINARY:
+                    return {location, Value(Blob(file.file, bytes(varint())))};
+
+                case Value::BOOLEAN:
+                    return {location, Value(byte() != 0)};
+
+                case Value::FLOAT: {
+                    double value;
+                    std::memcpy(&value, bytes(sizeof(value)).data(), sizeof(value));
+                    return {location, Value(value)};
+                }
+
+                case Value::SIGNED: {
+                    auto value = varint();
+                    auto default_size = varint();
+                    return {location, Value(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1), default_size)};
+                }
+
+                case Value::STRING:
+                    return {location, Value(symbol())};
+
+                case Value::UNSIGNED: {
+                    auto value = varint();
+                    auto default_size = varint();
+                    return {location, Value(value, default_size)};
+                }
+
+                case Value::VOID:
+                    return {location, Value()};
+
+                case Value::INTEGER:
+                case Value::NUMBER:
+                    break;
+            }
+            break;
+    }
+
+    throw Exception("invalid token in binary library '%s'", file.file_name.c_str());
+}
+
+
+uint64_t BinaryObjectFile::Reader::varint() {
+    uint64_t value = 0;
+    unsigned int shift = 0;
+
+    while (true) {
+        auto b = byte();
+        if (shift >= 64) {
+            throw Exception("invalid integer in binary library '%s'", file.file_name.c_str());
+        }
+        value |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+
+void BinaryObjectFile::Writer::token(const Token& token, std::unordered_map<Symbol, size_t>& symbols) {
+    auto symbol_index = [&symbols](Symbol symbol) {
+        return symbols.insert({symbol, symbols.size()}).first->second + 1;
+    };
+
+    byte(static_cast<uint8_t>(token.get_type()));
+    varint(token.location.start_line_number);
+    varint(token.location.start_column);
+    varint(token.location.end_column);
+
+    switch (token.get_type()) {
+        case Token::DIRECTIVE:
+        case Token::INSTRUCTION:
+        case Token::KEYWORD:
+        case Token::NAME:
+        case Token::PREPROCESSOR:
+        case Token::PUNCTUATION:
+        case Token::STRING:
+            varint(symbol_index(token.as_symbol()));
+            break;
+
+        case Token::END:
+        case Token::NEWLINE:
+            break;
+
+        case Token::VALUE: {
+            auto value = token.as_value();
+            byte(static_cast<uint8_t>(value.type()));
+            switch (value.type()) {
+                case Value::BINARY: {
+                    auto data = value.binary_value();
+                    varint(data.size());
+                    bytes(data);
+                    break;
+                }
+
+                case Value::BOOLEAN:
+                    byte(value.boolean_value() ? 1 : 0);
+                    break;
+
+                case Value::FLOAT: {
+                    auto number = value.float_value();
+                    char data[sizeof(number)];
+                    std::memcpy(data, &number, sizeof(number));
+                    bytes({data, sizeof(data)});
+                    break;
+                }
+
+                case Value::SIGNED: {
+                    auto number = value.signed_value();
+                    varint((static_cast<uint64_t>(number) << 1) ^ static_cast<uint64_t>(number >> 63));
+                    varint(value.default_size().value_or(0));
+                    break;
+                }
+
+                case Value::STRING:
+                    varint(symbol_index(value.symbol_value()));
+                    break;
+
+                case Value::UNSIGNED:
+                    varint(value.unsigned_value());
+                    varint(value.default_size().value_or(0));
+                    break;
+
+                case Value::VOID:
+                    break;
+
+                case Value::INTEGER:
+                case Value::NUMBER:
+                    throw Exception("internal error: value can't have abstract type %s", value.type_name().c_str());
+            }
+            break;
+        }
+    }
+}
+
+
+void BinaryObjectFile::Writer::varint(uint64_t value) {
+    while (value >= 0x80) {
+        byte(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    byte(static_cast<uint8_t>(value));
+}
@@ -0,0 +1,125 @@
+/*
+BinaryObjectFile.h -- precompiled library format
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef BINARY_OBJECT_FILE_H
+#define BINARY_OBJECT_FILE_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.h"
+#include "ObjectFileParser.h"
+#include "Symbol.h"
+#include "Token.h"
+
+class ObjectFile;
+
+/**
+ * Binary form of a library, read from a memory mapped file.
+ *
+ * The file starts with the line `.format_version 2.0`, followed by the table of all symbols used, an index of the
+ * top level directives, and the pre-tokenized directives themselves.
+ * Directives that don't define an entity are processed when the file is read. Constants, functions, macros, and
+ * objects are only parsed when their name is first looked up.
+ */
+class BinaryObjectFile {
+public:
+    BinaryObjectFile(Symbol file_name, std::shared_ptr<const MappedFile> file);
+
+    [[nodiscard]] static bool is_binary(const MappedFile& file) {return file.contents().starts_with(header());}
+    static std::shared_ptr<ObjectFile> read(Symbol file_name, std::shared_ptr<const MappedFile> file);
+    static void write(std::ostream& stream, const ObjectFile& file, Symbol file_name);
+
+    bool materialize(Symbol name);
+    void materialize_all(Symbol directive);
+
+    static const unsigned int format_version_major;
+    static const unsigned int format_version_minor;
+
+private:
+    class Section {
+    public:
+        Section(Symbol directive, Symbol name, size_t offset): directive{directive}, name{name}, offset{offset} {}
+
+        Symbol directive;
+        Symbol name;
+        size_t offset;
+        size_t count{0};
+    };
+
+    class Reader {
+    public:
+        Reader(const BinaryObjectFile& file, size_t offset);
+
+        uint8_t byte();
+        std::string_view bytes(size_t length);
+        Symbol symbol();
+        Token token();
+        uint64_t varint();
+
+    private:
+        const BinaryObjectFile& file;
+        const char* current;
+        const char* end;
+    };
+
+    class Writer {
+    public:
+        explicit Writer(std::ostream& stream): stream{stream} {}
+
+        void byte(uint8_t value) {stream.put(static_cast<char>(value));}
+        void bytes(std::string_view value) {stream.write(value.data(), static_cast<std::streamsize>(value.size()));}
+        void token(const Token& token, std::unordered_map<Symbol, size_t>& symbols);
+        void varint(uint64_t value);
+
+    private:
+        std::ostream& stream;
+    };
+
+    static const std::string& header();
+    static bool is_entity(Symbol directive);
+
+    std::vector<Token> tokens(const Section& section) const;
+
+    Symbol file_name;
+    std::shared_ptr<const MappedFile> file;
+    std::weak_ptr<ObjectFile> object_file;
+    ObjectFileParser parser;
+
+    std::vector<Symbol> symbols;
+    std::vector<Section> sections;
+    std::unordered_map<Symbol, std::vector<size_t>> pending;
+};
+
+#endif // BINARY_OBJECT_FILE_H
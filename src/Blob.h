@@ -0,0 +1,103 @@
+/*
+Blob.h -- Reference counted slice of binary data
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef BLOB_H
+#define BLOB_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+/// Immutable binary data that shares its storage with all copies and slices of it.
+class Blob {
+public:
+    /// @brief Create empty binary data.
+    Blob() = default;
+
+    /**
+     * Create binary data owning its storage.
+     *
+     * @param data The binary data.
+     */
+    explicit Blob(std::string data) {
+        auto storage = std::make_shared<const std::string>(std::move(data));
+        bytes = *storage;
+        owner = std::move(storage);
+    }
+
+    /**
+     * Create binary data referencing storage kept alive by `owner`, for example a memory mapped file.
+     *
+     * @param owner The object owning the storage.
+     * @param bytes The binary data, which must remain valid as long as `owner` exists.
+     */
+    Blob(std::shared_ptr<const void> owner, std::string_view bytes): owner{std::move(owner)}, bytes{bytes} {}
+
+    /**
+     * Check if binary data is empty.
+     *
+     * @return `true` if there is no data, `false` otherwise.
+     */
+    [[nodiscard]] bool empty() const {return bytes.empty();}
+
+    /**
+     * Get the size of the binary data.
+     *
+     * @return The size in bytes.
+     */
+    [[nodiscard]] size_t size() const {return bytes.size();}
+
+    /**
+     * Get part of the binary data without copying it.
+     *
+     * @param start The offset of the first byte.
+     * @param length The number of bytes, or up to the end if not specified.
+     * @return The binary data slice, sharing the storage of this blob.
+     * @throws std::out_of_range if `start` is larger than the size.
+     */
+    [[nodiscard]] Blob slice(size_t start, size_t length = std::string_view::npos) const {return {owner, bytes.substr(start, length)};}
+
+    /**
+     * Get the binary data.
+     *
+     * @return A view of the data, valid as long as this blob or a copy of it exists.
+     */
+    [[nodiscard]] std::string_view view() const {return bytes;}
+
+    bool operator==(const Blob& other) const {return bytes == other.bytes;}
+
+private:
+    /// @brief Keeps the storage `bytes` points into alive.
+    std::shared_ptr<const void> owner;
+    std::string_view bytes;
+};
+
+#endif // BLOB_H
@@ -31,6 +31,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BlockBody.h"
 
+#include <algorithm>
+
 #include "DataBody.h"
 
 BlockBody::BlockBody(std::vector<Body> block_) : block(std::move(block_)) {
@@ -100,7 +102,11 @@ std::optional<Body> BlockBody::append_sub(const Body& body, const Body& element)
     return new_body;
 }
 
-void BlockBody::encode(std::string& bytes, const Memory* memory) const {
+bool BlockBody::depends_on_position() const {
+    return std::ranges::any_of(block, [](const Body& element) {return element.depends_on_position();});
+}
+
+void BlockBody::encode(ByteSink& bytes, const Memory* memory) const {
     for (auto& element : block) {
         element.encode(bytes, memory);
     }
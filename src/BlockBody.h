@@ -44,8 +44,9 @@ public:
 
     [[nodiscard]] std::optional<Body> append_sub(const Body& body, const Body& element) override;
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<BlockBody>(block);}
+    [[nodiscard]] bool depends_on_position() const override;
     [[nodiscard]] bool empty() const override {return block.empty();}
-    void encode(std::string &bytes, const Memory* memory) const override;
+    void encode(ByteSink& bytes, const Memory* memory) const override;
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override;
     [[nodiscard]] std::optional<Body> back() const {if (block.empty()) {return {};} else {return block.back();}}
 
@@ -78,9 +78,10 @@ public:
     std::optional<Body> append_sub(const Body& element);
     [[nodiscard]] std::optional<Body> back() const;
     void collect_objects(std::unordered_set<Object*>& objects) const {element->collect_objects(objects);}
+    [[nodiscard]] bool depends_on_position() const {return element->depends_on_position();}
     [[nodiscard]] bool empty() const {return element->empty();}
     [[nodiscard]] Body make_unique() const;
-    void encode(std::string& bytes, const Memory* memory = nullptr) const {element->encode(bytes, memory);}
+    void encode(ByteSink& bytes, const Memory* memory = nullptr) const {element->encode(bytes, memory);}
     bool evaluate(const EvaluationContext& context);
     [[nodiscard]] std::optional<Body> evaluated (const EvaluationContext& context) const;
     [[nodiscard]] bool is_block() const {return as_block() != nullptr;}
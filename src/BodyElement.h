@@ -34,6 +34,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <optional>
 
+#include "ByteSink.h"
 #include "Environment.h"
 #include "Memory.h"
 #include "SizeRange.h"
@@ -53,8 +54,9 @@ public:
 
     virtual void collect_objects(std::unordered_set<Object*>& objects) const {}
     [[nodiscard]] virtual std::shared_ptr<BodyElement> clone() const = 0;
+    [[nodiscard]] virtual bool depends_on_position() const {return false;} // Whether the element defines labels or otherwise depends on its offset within the object.
     [[nodiscard]] virtual bool empty() const = 0;
-    virtual void encode(std::string& bytes, const Memory* memory) const = 0;
+    virtual void encode(ByteSink& bytes, const Memory* memory) const = 0;
     [[nodiscard]] virtual std::optional<Body> evaluated(const EvaluationContext& context) const = 0;
     virtual void serialize(std::ostream& stream, const std::string& prefix) const = 0;
 
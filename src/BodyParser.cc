@@ -544,16 +544,16 @@ void BodyParser::parse_binary_file() {
             start = argument.as_unsigned();
         }
         else if (directive == token_length) {
-            if (start) {
+            if (length) {
                 throw ParseException(directive, "duplicate .length");
             }
             length = argument.as_unsigned();
         }
         else if (directive == token_end) {
-            if (start) {
+            if (end) {
                 throw ParseException(directive, "duplicate .end");
             }
-            length = argument.as_unsigned();
+            end = argument.as_unsigned();
         }
     }
 
@@ -577,10 +577,10 @@ void BodyParser::parse_binary_file() {
             throw ParseException(filename, "specified range exceeds file data");
         }
         if (end) {
-            data = data.substr(*start, *end - *start + 1);
+            data = data.slice(*start, *end - *start + 1);
         }
         else if (start > 0) {
-            data = data.substr(*start);
+            data = data.slice(*start);
         }
         auto elements = std::vector<DataBodyElement>{DataBodyElement{Expression{filename.location, Value(data)}, {}}};
         current_body->append(Body(elements));
@@ -0,0 +1,151 @@
+/*
+ByteSink.h -- destination for encoded bytes
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef BYTE_SINK_H
+#define BYTE_SINK_H
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Exception.h"
+
+/// Destination for encoded bytes, either appending to a string, writing in place into a fixed region, for example an object's space in memory, or streaming to a file.
+class ByteSink {
+public:
+    /**
+     * Create sink appending to a string.
+     *
+     * @param string The string to append to, which must outlive the sink.
+     */
+    explicit ByteSink(std::string& string): string{&string} {}
+
+    /**
+     * Create sink writing into a fixed region.
+     *
+     * @param region The region to write to, which must outlive the sink.
+     */
+    explicit ByteSink(std::span<char> region): region{region} {}
+
+    /**
+     * Create sink writing to a stream.
+     *
+     * @param stream The stream to write to, which must outlive the sink.
+     */
+    explicit ByteSink(std::ostream& stream): stream{&stream} {}
+
+    /**
+     * Append a byte.
+     *
+     * @param byte The byte to append.
+     * @throws Exception if the region is full.
+     */
+    void append(char byte) {
+        if (string) {
+            *string += byte;
+        }
+        else if (stream) {
+            stream->put(byte);
+            position += 1;
+        }
+        else {
+            reserve(1);
+            region[position++] = byte;
+        }
+    }
+
+    /**
+     * Append bytes.
+     *
+     * @param bytes The bytes to append.
+     * @throws Exception if they don't fit in the region.
+     */
+    void append(std::string_view bytes) {
+        if (string) {
+            *string += bytes;
+        }
+        else if (stream) {
+            stream->write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            position += bytes.size();
+        }
+        else {
+            reserve(bytes.size());
+            bytes.copy(region.data() + position, bytes.size());
+            position += bytes.size();
+        }
+    }
+
+    /**
+     * Append a byte repeatedly.
+     *
+     * @param count The number of bytes to append.
+     * @param byte The byte to append.
+     * @throws Exception if they don't fit in the region.
+     */
+    void append(size_t count, char byte) {
+        if (string) {
+            string->append(count, byte);
+        }
+        else if (stream) {
+            std::fill_n(std::ostreambuf_iterator<char>(*stream), count, byte);
+            position += count;
+        }
+        else {
+            reserve(count);
+            std::fill_n(region.begin() + static_cast<std::ptrdiff_t>(position), count, byte);
+            position += count;
+        }
+    }
+
+    /**
+     * Get the number of bytes written so far.
+     *
+     * @return The number of bytes written, or the size of the string appended to.
+     */
+    [[nodiscard]] size_t size() const {return string ? string->size() : position;}
+
+private:
+    void reserve(size_t count) const {
+        if (count > region.size() - position) {
+            throw Exception("encoded data exceeds space of %zu bytes", region.size());
+        }
+    }
+
+    std::string* string{};
+    std::ostream* stream{};
+    std::span<char> region;
+    size_t position{0};
+};
+
+#endif // BYTE_SINK_H
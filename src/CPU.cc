@@ -32,6 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CPU.h"
 
 #include <algorithm>
+#include <ranges>
 
 #include "CPUGetter.h"
 
@@ -43,11 +44,29 @@ void CPU::add_addressing_mode(Symbol name, AddressingMode mode) {
     auto& addressing_mode = addressing_modes[name];
 
     addressing_mode.priority = addressing_modes.size();
+}
+
+void CPU::compile() {
+    // The matcher expects addressing modes in order of priority.
+    auto sorted_modes = std::vector<std::pair<Symbol, AddressingMode*>>();
+    for (auto& [name, addressing_mode]: addressing_modes) {
+        sorted_modes.emplace_back(name, &addressing_mode);
+    }
+    std::ranges::sort(sorted_modes, [](const auto& a, const auto& b) {return a.second->priority < b.second->priority;});
 
-    size_t notation_index = 0;
-    for (const auto& notation: addressing_mode.notations) {
-        addressing_mode_matcher.add_notation(name, notation_index, notation, addressing_mode.arguments);
-        notation_index += 1;
+    for (const auto& [name, addressing_mode]: sorted_modes) {
+        auto argument_names = std::vector<Symbol>();
+        for (const auto& argument_name: addressing_mode->arguments | std::views::keys) {
+            argument_names.emplace_back(argument_name);
+        }
+        addressing_mode->encoding_template = EncodingTemplate::compile(addressing_mode->encoding, std::move(argument_names));
+        addressing_mode->resolve_arguments();
+
+        size_t notation_index = 0;
+        for (const auto& notation: addressing_mode->notations) {
+            addressing_mode_matcher.add_notation(name, notation_index, notation, addressing_mode->arguments);
+            notation_index += 1;
+        }
     }
 }
 
@@ -121,11 +140,6 @@ bool CPU::is_compatible_with(const CPU &other) const {
 }
 
 
-std::vector<AddressingModeMatcherResult> CPU::match_addressing_modes(const std::vector<std::shared_ptr<Node>>& arguments) const {
-    auto matches = addressing_mode_matcher.match(arguments);
-    auto v = std::vector<AddressingModeMatcherResult>(matches.begin(), matches.end());
-    std::ranges::sort(v, [this](const AddressingModeMatcherResult& a, const AddressingModeMatcherResult& b) -> bool {
-             return *addressing_mode(a.addressing_mode) < *addressing_mode(b.addressing_mode);
-         });
-    return v;
+const std::vector<AddressingModeMatcherResult>& CPU::match_addressing_modes(const std::vector<std::shared_ptr<Node>>& arguments) const {
+    return addressing_mode_matcher.match(arguments);
 }
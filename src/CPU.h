@@ -50,15 +50,20 @@ public:
     [[nodiscard]] bool is_compatible_with(const CPU& other) const; // this has everything from other
 
     uint64_t byte_order = 0;
+    std::vector<Symbol> files; // Files read while parsing the definition.
 
     [[nodiscard]] const AddressingMode* addressing_mode(Symbol name) const;
+    [[nodiscard]] const std::unordered_map<Symbol, Instruction>& all_instructions() const {return instructions;}
     [[nodiscard]] const ArgumentType* argument_type(Symbol name) const;
     [[nodiscard]] const Instruction* instruction(Symbol name) const;
 
-    [[nodiscard]] std::vector<AddressingModeMatcherResult> match_addressing_modes(const std::vector<std::shared_ptr<Node>>& arguments) const;
+    [[nodiscard]] const std::vector<AddressingModeMatcherResult>& match_addressing_modes(const std::vector<std::shared_ptr<Node>>& arguments) const;
 
     void setup(FileTokenizer& tokenizer) const;
 
+    // Build addressing mode matcher and encoding templates. Must be called once all addressing modes have been added.
+    void compile();
+
     [[nodiscard]] bool uses_empty_mnemonic() const {return instructions.contains(Symbol());}
     [[nodiscard]] bool uses_braces() const {return uses_punctuation(Symbol("("));}
     [[nodiscard]] bool uses_punctuation(Symbol symbol) const {return punctuation.contains(symbol);}
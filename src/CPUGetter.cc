@@ -31,4 +31,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CPUGetter.h"
 
-CPUGetter CPUGetter::global;
\ No newline at end of file
+#include "FileReader.h"
+
+CPUGetter CPUGetter::global;
+
+CPU CPUGetter::parse(Symbol name, Symbol filename) {
+    auto recording = FileReader::Recording();
+    auto cpu = CPUParser().parse(filename);
+    cpu.files = recording.files;
+    return cpu;
+}
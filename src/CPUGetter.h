@@ -42,7 +42,7 @@ public:
 
 protected:
     std::string filename_extension() const override {return ".cpu";}
-    CPU parse(Symbol name, Symbol filename) override {return CPUParser().parse(filename);}
+    CPU parse(Symbol name, Symbol filename) override;
 };
 
 
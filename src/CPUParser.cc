@@ -44,7 +44,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 std::unordered_map<Symbol, std::unique_ptr<ArgumentType> (CPUParser::*)(const Token& name, const ParsedValue* parameters)> CPUParser::argument_type_parser_methods;
 std::unordered_map<Symbol, void (CPUParser::*)()> CPUParser::parser_methods;
 
-bool CPUParser::initialized = false;
+std::once_flag CPUParser::initialized;
 Token CPUParser::token_arguments;
 Token CPUParser::token_any;
 Token CPUParser::token_comma;
@@ -57,7 +57,7 @@ Token CPUParser::token_pc;
 Token CPUParser::token_punctuation;
 
 void CPUParser::initialize() {
-    if (!initialized) {
+    std::call_once(initialized, [] {
         token_arguments = Token(Token::NAME, "arguments");
         token_any = Token(Token::NAME, "any");
         token_comma = Token(Token::PUNCTUATION, ",");
@@ -80,8 +80,7 @@ void CPUParser::initialize() {
         argument_type_parser_methods[Symbol("map")] = &CPUParser::parse_argument_type_map;
         argument_type_parser_methods[Symbol("range")] = &CPUParser::parse_argument_type_range;
 
-        initialized = true;
-    }
+    });
 }
 
 CPUParser::CPUParser(): FileParser(*CPUGetter::global.path) {
@@ -99,6 +98,7 @@ CPU CPUParser::parse(Symbol file_name) {
     if (!parse_file(file_name)) {
         throw Exception("can't parse CPU file '%s'", file_name.c_str());
     }
+    cpu.compile();
     return std::move(cpu);
 }
 
@@ -32,6 +32,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CPU_PARSER_H
 #define CPU_PARSER_H
 
+#include <mutex>
+
 #include "CPU.h"
 #include "FileReader.h"
 #include "Symbol.h"
@@ -69,7 +71,7 @@ private:
     std::unordered_set<Token> argument_type_names;
 
     static void initialize();
-    static bool initialized;
+    static std::once_flag initialized;
     static Token token_any;
     static Token token_arguments;
     static Token token_comma;
@@ -31,6 +31,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Callable.h"
 
+#include <algorithm>
+
 #include "EvaluationContext.h"
 #include "Exception.h"
 #include "ParseException.h"
@@ -38,14 +40,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define ARGUMENTS "arguments"
 
-bool Callable::initialized = false;
+std::once_flag Callable::initialized;
 Token Callable::token_arguments;
 
 void Callable::initialize() {
-    if (!initialized) {
-        initialized = true;
+    std::call_once(initialized, [] {
         token_arguments = Token(Token::NAME, ARGUMENTS);
-    }
+    });
 }
 
 Callable::Callable(ObjectFile* owner, const Token& name_, const std::shared_ptr<ParsedValue>& definition): Entity(owner, name_, definition) {
@@ -111,6 +112,30 @@ std::shared_ptr<Environment> Callable::bind(const std::vector<Expression>& actua
     return environment;
 }
 
+std::optional<std::vector<Value>> Callable::constant_arguments(const std::vector<Expression>& actual_arguments) {
+    auto values = std::vector<Value>{};
+    values.reserve(actual_arguments.size());
+    for (const auto& argument: actual_arguments) {
+        if (!argument.has_value()) {
+            return {};
+        }
+        values.emplace_back(*argument.value());
+    }
+    return values;
+}
+
+size_t Callable::ArgumentsHash::operator()(const std::vector<Value>& values) const {
+    size_t hash = values.size();
+    for (const auto& value: values) {
+        hash = hash * 31 + std::hash<Value>{}(value);
+    }
+    return hash;
+}
+
+bool Callable::ArgumentsEqual::operator()(const std::vector<Value>& a, const std::vector<Value>& b) const {
+    return std::ranges::equal(a, b, [](const Value& x, const Value& y) {return x.type() == y.type() && x == y;});
+}
+
 EvaluationContext Callable::evaluation_context(EvaluationResult& result) {
     return Entity::evaluation_context(result).skipping_variables(arguments.names);
 }
@@ -32,6 +32,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CALLABLE_H
 #define CALLABLE_H
 
+#include <mutex>
+
 #include "Entity.h"
 #include "EvaluationContext.h"
 #include "Expression.h"
@@ -61,17 +63,26 @@ class Callable: public Entity {
     [[nodiscard]] std::optional<Expression> default_argument(size_t index) const {return arguments.default_argument(index);}
 
   protected:
+    // Hash and equality for caches keyed by argument values. Values of different types must not share an entry, since they bind differently.
+    struct ArgumentsHash {
+        size_t operator()(const std::vector<Value>& values) const;
+    };
+    struct ArgumentsEqual {
+        bool operator()(const std::vector<Value>& a, const std::vector<Value>& b) const;
+    };
+
     Arguments arguments;
 
     [[nodiscard]] EvaluationContext evaluation_context(EvaluationResult& result) override;
 
     [[nodiscard]] std::shared_ptr<Environment> bind(const std::vector<Expression>& actual_arguments) const;
+    [[nodiscard]] static std::optional<std::vector<Value>> constant_arguments(const std::vector<Expression>& actual_arguments);
     void serialize_callable(std::ostream& stream) const;
 
   private:
     static void initialize();
 
-    static bool initialized;
+    static std::once_flag initialized;
     static Token token_arguments;
 };
 
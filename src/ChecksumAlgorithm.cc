@@ -31,16 +31,31 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ChecksumAlgorithm.h"
 
+#include "ChecksumAlgorithmAdler32.h"
+#include "ChecksumAlgorithmCrc16.h"
+#include "ChecksumAlgorithmCrc32.h"
+#include "ChecksumAlgorithmFletcher16.h"
+#include "ChecksumAlgorithmSum.h"
 #include "ChecksumAlgorithmXor.h"
 #include "Exception.h"
+#include "Int.h"
+#include "IntegerEncoder.h"
 
 // clang-format off
 const std::unordered_map<Symbol, std::shared_ptr<ChecksumAlgorithm>(*)(Symbol)> ChecksumAlgorithm::algorithms = {
+    {Symbol{"adler32"}, &ChecksumAlgorithmAdler32::create},
+    {Symbol{"crc16"}, &ChecksumAlgorithmCrc16::create},
+    {Symbol{"crc32"}, &ChecksumAlgorithmCrc32::create},
+    {Symbol{"fletcher16"}, &ChecksumAlgorithmFletcher16::create},
+    {Symbol{"sum8"}, &ChecksumAlgorithmSum::create},
+    {Symbol{"sum16"}, &ChecksumAlgorithmSum::create},
     {Symbol{"xor"}, &ChecksumAlgorithmXor::create}
 };
 // clang-format on
 
+const Symbol ChecksumAlgorithm::parameter_big_endian{"big_endian"};
 const std::unordered_set<Symbol> ChecksumAlgorithm::no_parameters{};
+const std::unordered_set<Symbol> ChecksumAlgorithm::byte_order_parameters{parameter_big_endian};
 
 std::shared_ptr<ChecksumAlgorithm> ChecksumAlgorithm::create(Symbol algorithm_name) {
     auto it = algorithms.find(algorithm_name);
@@ -51,3 +66,21 @@ std::shared_ptr<ChecksumAlgorithm> ChecksumAlgorithm::create(Symbol algorithm_na
 
     throw Exception("unknown checksum algorithm " + algorithm_name.str());
 }
+
+std::string ChecksumAlgorithm::encode(uint64_t value, const std::unordered_map<Symbol, Value>& parameters) const {
+    auto byte_order = IntegerEncoder::little_endian_byte_order;
+    auto it = parameters.find(parameter_big_endian);
+    if (it != parameters.end() && it->second.boolean_value()) {
+        byte_order = IntegerEncoder::big_endian_byte_order;
+    }
+
+    auto result = std::string{};
+    auto sink = ByteSink(result);
+    Int::encode(sink, value, result_size(), byte_order);
+    return result;
+}
+
+const std::unordered_set<Symbol>& ChecksumAlgorithm::parameter_names() const {
+    // Byte order only matters for results longer than one byte.
+    return result_size() > 1 ? byte_order_parameters : no_parameters;
+}
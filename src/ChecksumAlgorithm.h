@@ -33,6 +33,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <cstdint>
+#include <memory>
+#include <span>
 
 #include "Symbol.h"
 #include "Tokenizer.h"
@@ -40,21 +42,35 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 class ChecksumAlgorithm {
   public:
+    // Checksum of data passed in one or more consecutive pieces.
+    class State {
+      public:
+        virtual ~State() = default;
+
+        virtual void update(std::span<const uint8_t> data) = 0;
+        [[nodiscard]] virtual uint64_t value() const = 0;
+    };
+
     ChecksumAlgorithm(Symbol name): name{name} {}
     virtual ~ChecksumAlgorithm() = default;
 
     static std::shared_ptr<ChecksumAlgorithm> create(Symbol algorithm_name);
 
-    virtual std::string compute(std::string::const_iterator begin, std::string::const_iterator end, const std::unordered_map<Symbol, Value>& parameters) = 0;
-    virtual uint64_t result_size() = 0;
-    virtual const std::unordered_set<Symbol>& parameter_names() const {return no_parameters;}
+    [[nodiscard]] virtual std::unique_ptr<State> start(const std::unordered_map<Symbol, Value>& parameters) const = 0;
+    [[nodiscard]] std::string encode(uint64_t value, const std::unordered_map<Symbol, Value>& parameters) const;
+    [[nodiscard]] virtual uint64_t result_size() const = 0;
+    [[nodiscard]] virtual const std::unordered_set<Symbol>& parameter_names() const;
 
     Symbol name;
 
+  protected:
+    static const Symbol parameter_big_endian;
+
   private:
     static const std::unordered_map<Symbol, std::shared_ptr<ChecksumAlgorithm>(*)(Symbol)> algorithms;
 
     static const std::unordered_set<Symbol> no_parameters;
+    static const std::unordered_set<Symbol> byte_order_parameters;
 };
 
 
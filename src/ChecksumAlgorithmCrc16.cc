@@ -0,0 +1,81 @@
+/*
+ChecksumAlgorithmCrc16.cc --
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ChecksumAlgorithmCrc16.h"
+
+const Symbol ChecksumAlgorithmCrc16::parameter_initial{"initial"};
+
+constexpr ChecksumAlgorithmCrc16::Table ChecksumAlgorithmCrc16::make_table() {
+    auto new_table = Table{};
+
+    for (uint16_t byte = 0; byte < 256; byte++) {
+        auto crc = static_cast<uint16_t>(byte << 8);
+        for (auto bit = 0; bit < 8; bit++) {
+            crc = static_cast<uint16_t>(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+        }
+        new_table[0][byte] = crc;
+    }
+    for (size_t k = 1; k < new_table.size(); k++) {
+        for (size_t byte = 0; byte < 256; byte++) {
+            auto previous = new_table[k - 1][byte];
+            new_table[k][byte] = static_cast<uint16_t>((previous << 8) ^ new_table[0][previous >> 8]);
+        }
+    }
+
+    return new_table;
+}
+
+const ChecksumAlgorithmCrc16::Table ChecksumAlgorithmCrc16::table = make_table();
+
+std::unique_ptr<ChecksumAlgorithm::State> ChecksumAlgorithmCrc16::start(const std::unordered_map<Symbol, Value>& parameters) const {
+    auto initial = uint16_t{0xffff};
+    auto it = parameters.find(parameter_initial);
+    if (it != parameters.end()) {
+        initial = static_cast<uint16_t>(it->second.unsigned_value());
+    }
+    return std::make_unique<Crc16State>(initial);
+}
+
+const std::unordered_set<Symbol>& ChecksumAlgorithmCrc16::parameter_names() const {
+    // Not a static member, since parameter_big_endian may not be initialized yet when static members of this file are.
+    static const auto names = std::unordered_set<Symbol>{parameter_big_endian, parameter_initial};
+    return names;
+}
+
+void ChecksumAlgorithmCrc16::Crc16State::update(std::span<const uint8_t> data) {
+    while (data.size() >= 8) {
+        crc = table[7][(crc >> 8) ^ data[0]] ^ table[6][(crc & 0xff) ^ data[1]] ^ table[5][data[2]] ^ table[4][data[3]] ^ table[3][data[4]] ^ table[2][data[5]] ^ table[1][data[6]] ^ table[0][data[7]];
+        data = data.subspan(8);
+    }
+    for (auto byte: data) {
+        crc = static_cast<uint16_t>((crc << 8) ^ table[0][(crc >> 8) ^ byte]);
+    }
+}
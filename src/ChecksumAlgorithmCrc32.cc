@@ -0,0 +1,65 @@
+/*
+ChecksumAlgorithmCrc32.cc --
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ChecksumAlgorithmCrc32.h"
+
+constexpr ChecksumAlgorithmCrc32::Table ChecksumAlgorithmCrc32::make_table() {
+    auto new_table = Table{};
+
+    for (uint32_t byte = 0; byte < 256; byte++) {
+        auto crc = byte;
+        for (auto bit = 0; bit < 8; bit++) {
+            crc = crc & 1 ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+        }
+        new_table[0][byte] = crc;
+    }
+    for (size_t k = 1; k < new_table.size(); k++) {
+        for (size_t byte = 0; byte < 256; byte++) {
+            auto previous = new_table[k - 1][byte];
+            new_table[k][byte] = (previous >> 8) ^ new_table[0][previous & 0xff];
+        }
+    }
+
+    return new_table;
+}
+
+const ChecksumAlgorithmCrc32::Table ChecksumAlgorithmCrc32::table = make_table();
+
+void ChecksumAlgorithmCrc32::Crc32State::update(std::span<const uint8_t> data) {
+    while (data.size() >= 8) {
+        crc ^= static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 | static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+        crc = table[7][crc & 0xff] ^ table[6][(crc >> 8) & 0xff] ^ table[5][(crc >> 16) & 0xff] ^ table[4][crc >> 24] ^ table[3][data[4]] ^ table[2][data[5]] ^ table[1][data[6]] ^ table[0][data[7]];
+        data = data.subspan(8);
+    }
+    for (auto byte: data) {
+        crc = (crc >> 8) ^ table[0][(crc ^ byte) & 0xff];
+    }
+}
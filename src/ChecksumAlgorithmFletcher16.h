@@ -0,0 +1,57 @@
+#ifndef CHECKSUM_ALGORITHM_FLETCHER16_H
+#define CHECKSUM_ALGORITHM_FLETCHER16_H
+
+/*
+ChecksumAlgorithmFletcher16.h --
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ChecksumAlgorithm.h"
+
+class ChecksumAlgorithmFletcher16: public ChecksumAlgorithm {
+  public:
+    ChecksumAlgorithmFletcher16(Symbol name): ChecksumAlgorithm(name) {}
+    static std::shared_ptr<ChecksumAlgorithm> create(Symbol algorithm_name){return std::make_shared<ChecksumAlgorithmFletcher16>(algorithm_name);}
+
+    [[nodiscard]] uint64_t result_size() const override {return 2;}
+    [[nodiscard]] std::unique_ptr<State> start(const std::unordered_map<Symbol, Value>& parameters) const override {return std::make_unique<Fletcher16State>();}
+
+  private:
+    class Fletcher16State: public State {
+      public:
+        void update(std::span<const uint8_t> data) override;
+        [[nodiscard]] uint64_t value() const override {return (sum2 << 8) | sum1;}
+
+      private:
+        uint32_t sum1{0};
+        uint32_t sum2{0};
+    };
+};
+
+#endif // CHECKSUM_ALGORITHM_FLETCHER16_H
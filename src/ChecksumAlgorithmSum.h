@@ -0,0 +1,61 @@
+#ifndef CHECKSUM_ALGORITHM_SUM_H
+#define CHECKSUM_ALGORITHM_SUM_H
+
+/*
+ChecksumAlgorithmSum.h --
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ChecksumAlgorithm.h"
+
+class ChecksumAlgorithmSum: public ChecksumAlgorithm {
+  public:
+    ChecksumAlgorithmSum(Symbol name, uint64_t size): ChecksumAlgorithm(name), size{size} {}
+    static std::shared_ptr<ChecksumAlgorithm> create(Symbol algorithm_name);
+
+    [[nodiscard]] uint64_t result_size() const override {return size;}
+    [[nodiscard]] std::unique_ptr<State> start(const std::unordered_map<Symbol, Value>& parameters) const override {return std::make_unique<SumState>(size);}
+
+  private:
+    class SumState: public State {
+      public:
+        explicit SumState(uint64_t size): mask{(uint64_t{1} << (size * 8)) - 1} {}
+
+        void update(std::span<const uint8_t> data) override;
+        [[nodiscard]] uint64_t value() const override {return sum & mask;}
+
+      private:
+        uint64_t mask;
+        uint64_t sum{0}; // Truncated to result size in value().
+    };
+
+    uint64_t size;
+};
+
+#endif // CHECKSUM_ALGORITHM_SUM_H
@@ -30,16 +30,25 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ChecksumAlgorithmXor.h"
-#include "Int.h"
-#include "IntegerEncoder.h"
 
-std::string ChecksumAlgorithmXor::compute(std::string::const_iterator begin, std::string::const_iterator end, const std::unordered_map<Symbol, Value>& parameters) {
-    uint8_t checksum = 0;
-    for (auto it = begin; it != end; ++it) {
-        checksum ^= *it;
-    }
+#include <cstring>
 
-    auto result = std::string{};
-    Int::encode(result, static_cast<uint64_t>(checksum), 1, IntegerEncoder::little_endian_byte_order);
-    return result;
-}
\ No newline at end of file
+void ChecksumAlgorithmXor::XorState::update(std::span<const uint8_t> data) {
+    // XOR eight bytes at a time, value() folds them into one.
+    auto words = data.size() / sizeof(uint64_t);
+    for (size_t index = 0; index < words; index++) {
+        uint64_t word;
+        memcpy(&word, data.data() + index * sizeof(uint64_t), sizeof(word));
+        checksum ^= word;
+    }
+    for (auto byte: data.subspan(words * sizeof(uint64_t))) {
+        checksum ^= byte;
+    }
+}
+
+uint64_t ChecksumAlgorithmXor::XorState::value() const {
+    auto folded = checksum ^ (checksum >> 32);
+    folded ^= folded >> 16;
+    folded ^= folded >> 8;
+    return folded & 0xff;
+}
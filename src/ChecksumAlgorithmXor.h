@@ -39,8 +39,18 @@ class ChecksumAlgorithmXor: public ChecksumAlgorithm {
     ChecksumAlgorithmXor(Symbol name): ChecksumAlgorithm(name) {}
     static std::shared_ptr<ChecksumAlgorithm> create(Symbol algorithm_name){return std::make_shared<ChecksumAlgorithmXor>(algorithm_name);}
 
-    uint64_t result_size() override {return 1;}
-    std::string compute(std::string::const_iterator begin, std::string::const_iterator end, const std::unordered_map<Symbol, Value> &parameters) override;
+    [[nodiscard]] uint64_t result_size() const override {return 1;}
+    [[nodiscard]] std::unique_ptr<State> start(const std::unordered_map<Symbol, Value>& parameters) const override {return std::make_unique<XorState>();}
+
+  private:
+    class XorState: public State {
+      public:
+        void update(std::span<const uint8_t> data) override;
+        [[nodiscard]] uint64_t value() const override;
+
+      private:
+        uint64_t checksum{0}; // XOR of 8 byte words, folded in value().
+    };
 };
 
 #endif // CHECKSUM_ALGORITHM_XOR_H
@@ -30,6 +30,10 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ChecksumBody.h"
+
+#include <algorithm>
+#include <ranges>
+
 #include "Body.h"
 #include "ExpressionParser.h"
 #include "ParseException.h"
@@ -57,7 +61,7 @@ Body ChecksumBody::parse(Tokenizer& tokenizer) {
         auto parameter = expression_parser.parse();
 
         if (!parameter_names.contains(parameter_name.as_symbol())) {
-            throw ParseException(parameter_name, "unknown parameter" + parameter_name.as_string() + " for algorithm " + algorithm_name.as_string());
+            throw ParseException(parameter_name, "unknown parameter " + parameter_name.as_string() + " for algorithm " + algorithm_name.as_string());
         }
         parameters[parameter_name.as_symbol()] = parameter;
     }
@@ -65,10 +69,8 @@ Body ChecksumBody::parse(Tokenizer& tokenizer) {
     return Body(std::make_shared<ChecksumBody>(algorithm, start, end, parameters));
 }
 
-void ChecksumBody::encode(std::string& bytes, const Memory* memory) const {
-    for (size_t i = 0; i < algorithm->result_size(); i++) {
-        bytes += '\0';
-    }
+void ChecksumBody::encode(ByteSink& bytes, const Memory* memory) const {
+    bytes.append(algorithm->result_size(), '\0');
 }
 
 std::optional<Body> ChecksumBody::evaluated(const EvaluationContext& context) const {
@@ -117,6 +119,13 @@ std::optional<Body> ChecksumBody::evaluated(const EvaluationContext& context) co
 
 void ChecksumBody::serialize(std::ostream& stream, const std::string& prefix) const {
     stream << prefix << ".checksum " << algorithm->name << ", " << start << ", " << end;
-    // TODO: parameters
+    auto names = std::vector<Symbol>{};
+    for (const auto& name: parameters | std::views::keys) {
+        names.push_back(name);
+    }
+    std::ranges::sort(names);
+    for (auto name: names) {
+        stream << ", " << name << " " << parameters.at(name);
+    }
     stream << std::endl;
 }
@@ -46,8 +46,9 @@ class ChecksumBody: public BodyElement {
     static Body parse(Tokenizer& tokenizer);
 
     std::shared_ptr<BodyElement> clone() const override {throw Exception("can't clone .checksum");}
+    bool depends_on_position() const override {return true;}
     bool empty() const override {return false;}
-    void encode(std::string &bytes, const Memory *memory) const override;
+    void encode(ByteSink& bytes, const Memory *memory) const override;
     std::optional<Body> evaluated(const EvaluationContext &context) const override;
     void serialize(std::ostream &stream, const std::string &prefix) const override;
 
@@ -31,7 +31,113 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ChecksumComputation.h"
 
-void ChecksumComputation::compute(std::string& data) const {
-    auto result = algorithm->compute(data.cbegin() + static_cast<std::string::iterator::difference_type>(start), data.cbegin() + static_cast<std::string::iterator::difference_type>(end) + 1, parameters);
-    data.replace(result_position, result.length(), result);
+#include <algorithm>
+#include <cinttypes>
+
+#include "Exception.h"
+
+void ChecksumComputation::compute(std::iostream& data, const std::vector<ChecksumComputation>& checksums) {
+    if (checksums.empty()) {
+        // Don't seek, so output without checksums can be written to pipes.
+        return;
+    }
+
+    data.seekg(0, std::ios::end);
+    auto data_size = static_cast<uint64_t>(data.tellg());
+    auto pending = std::vector<const ChecksumComputation*>{};
+    for (const auto& checksum: checksums) {
+        if (!checksum.empty() && checksum.end >= data_size) {
+            throw Exception("checksum range $%" PRIx64 "-$%" PRIx64 " exceeds output", checksum.start, checksum.end);
+        }
+        pending.push_back(&checksum);
+    }
+
+    while (!pending.empty()) {
+        // A checksum can be computed in this pass if all results stored in its range are computed in it as well and patched before they are read, i.e. they are stored after their own range.
+        auto pass = pending;
+        auto changed = true;
+        while (changed) {
+            auto new_pass = std::vector<const ChecksumComputation*>{};
+            for (auto checksum: pass) {
+                if (std::ranges::none_of(pending, [checksum, &pass](const ChecksumComputation* other) {return checksum->depends_on(*other) && (std::ranges::find(pass, other) == pass.end() || other->result_position <= other->end);})) {
+                    new_pass.push_back(checksum);
+                }
+            }
+            changed = new_pass.size() != pass.size();
+            pass = std::move(new_pass);
+        }
+        if (pass.empty()) {
+            // Circular dependencies, compute in order given.
+            pass.push_back(pending.front());
+        }
+
+        compute_pass(data, pass);
+        std::erase_if(pending, [&pass](const ChecksumComputation* checksum) {return std::ranges::find(pass, checksum) != pass.end();});
+    }
+}
+
+void ChecksumComputation::compute_pass(std::iostream& data, const std::vector<const ChecksumComputation*>& checksums) {
+    constexpr uint64_t buffer_size = 64 * 1024;
+
+    auto states = std::vector<std::unique_ptr<ChecksumAlgorithm::State>>{};
+    auto boundaries = std::vector<uint64_t>{};
+    for (auto checksum: checksums) {
+        states.emplace_back(checksum->algorithm->start(checksum->parameters));
+        if (!checksum->empty()) {
+            boundaries.push_back(checksum->start);
+            boundaries.push_back(checksum->end + 1);
+        }
+    }
+    std::ranges::sort(boundaries);
+
+    auto finish = [&](size_t index) {
+        const auto checksum = checksums[index];
+        auto result = checksum->algorithm->encode(states[index]->value(), checksum->parameters);
+        data.seekp(static_cast<std::streamoff>(checksum->result_position));
+        data.write(result.data(), static_cast<std::streamsize>(result.size()));
+    };
+
+    for (size_t index = 0; index < checksums.size(); index++) {
+        if (checksums[index]->empty()) {
+            finish(index);
+        }
+    }
+
+    // Between consecutive boundaries, the same checksums are active.
+    auto buffer = std::vector<uint8_t>(buffer_size);
+    for (size_t boundary = 0; boundary + 1 < boundaries.size(); boundary++) {
+        auto segment_start = boundaries[boundary];
+        auto segment_end = boundaries[boundary + 1];
+
+        auto active = std::vector<size_t>{};
+        for (size_t index = 0; index < checksums.size(); index++) {
+            if (!checksums[index]->empty() && checksums[index]->start <= segment_start && checksums[index]->end >= segment_start) {
+                active.push_back(index);
+            }
+        }
+        if (segment_start == segment_end || active.empty()) {
+            continue;
+        }
+
+        for (auto position = segment_start; position < segment_end; position += buffer_size) {
+            auto chunk = std::span(buffer).first(std::min(buffer_size, segment_end - position));
+            data.seekg(static_cast<std::streamoff>(position));
+            if (!data.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()))) {
+                throw Exception("can't read output for checksum");
+            }
+            for (auto index: active) {
+                states[index]->update(chunk);
+            }
+        }
+
+        for (auto index: active) {
+            if (checksums[index]->end + 1 == segment_end) {
+                finish(index);
+            }
+        }
+    }
+}
+
+bool ChecksumComputation::depends_on(const ChecksumComputation& other) const {
+    return &other != this && !empty() && other.result_position <= end && other.result_position + other.algorithm->result_size() > start;
 }
@@ -33,7 +33,9 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <cstdint>
+#include <iostream>
 #include <memory>
+#include <vector>
 
 #include "ChecksumAlgorithm.h"
 
@@ -41,9 +43,15 @@ class ChecksumComputation {
   public:
     ChecksumComputation(std::shared_ptr<ChecksumAlgorithm> algorithm, uint64_t result_position, uint64_t start, uint64_t end, std::unordered_map<Symbol, Value> parameters): algorithm{std::move(algorithm)}, result_position{result_position}, start{start}, end{end}, parameters{std::move(parameters)} {}
 
-    void compute(std::string& data) const;
+    // Reads the checksummed ranges back from data and patches the results in place. Checksums are computed together in as few passes over data as their dependencies allow.
+    static void compute(std::iostream& data, const std::vector<ChecksumComputation>& checksums);
 
   private:
+    [[nodiscard]] bool depends_on(const ChecksumComputation& other) const;
+    [[nodiscard]] bool empty() const {return end < start;}
+
+    static void compute_pass(std::iostream& data, const std::vector<const ChecksumComputation*>& checksums);
+
     std::shared_ptr<ChecksumAlgorithm> algorithm;
     uint64_t result_position{};
     uint64_t start{};
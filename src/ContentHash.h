@@ -0,0 +1,62 @@
+/*
+ContentHash.h -- Hash identifying contents across runs
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstdint>
+#include <string_view>
+
+/// 64-bit FNV-1a hash of data, which unlike `std::hash` is the same in every run, so it can be stored in caches.
+class ContentHash {
+public:
+    /**
+     * Add data to the hash.
+     *
+     * @param data The data to add.
+     */
+    void add(std::string_view data);
+
+    /**
+     * Add an integer to the hash.
+     *
+     * @param value The integer to add.
+     */
+    void add(uint64_t value);
+
+    /// @brief The hash of all data added so far.
+    [[nodiscard]] uint64_t value() const {return hash;}
+
+private:
+    uint64_t hash = 0xcbf29ce484222325;
+};
+
+#endif // CONTENT_HASH_H
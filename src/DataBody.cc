@@ -97,7 +97,7 @@ std::optional<Body> DataBody::append_sub(const Body& body, const Body& element)
     return new_body;
 }
 
-void DataBody::encode(std::string& bytes, const Memory* memory) const {
+void DataBody::encode(ByteSink& bytes, const Memory* memory) const {
     for (auto& datum : data) {
         auto value = datum.expression.value();
         if (!value.has_value()) {
@@ -62,7 +62,7 @@ public:
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<DataBody>(data);}
     void collect_objects(std::unordered_set<Object*> &objects) const override;
     [[nodiscard]] bool empty() const override {return data.empty();}
-    void encode(std::string &bytes, const Memory* memory) const override;
+    void encode(ByteSink& bytes, const Memory* memory) const override;
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override;
 
     void serialize(std::ostream &stream, const std::string& prefix) const override;
@@ -55,7 +55,7 @@ std::optional<Expression> DefinedExpression::evaluated(const EvaluationContext&
         return{};
     }
 
-    if (context.defines.contains(symbol)) {
+    if (context.defined(symbol)) {
         return Expression(location, true);
     }
     else {
@@ -39,7 +39,7 @@ public:
     EmptyBody() = default;
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<EmptyBody>();}
     [[nodiscard]] bool empty() const override {return true;}
-    void encode(std::string &bytes, const Memory *memory) const override {}
+    void encode(ByteSink& bytes, const Memory *memory) const override {}
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override {return {};}
     void serialize(std::ostream &stream, const std::string &prefix) const override {}
 };
@@ -55,7 +55,7 @@ class Encoder {
     [[nodiscard]] bool operator==(const Encoder& other) const {return *encoder == other;}
     [[nodiscard]] bool operator==(const IntegerEncoder& other) const {return is_integer_encoder() && *as_integer_encoder() == other;}
 
-    void encode(std::string& bytes, const Value& value) const {return encoder->encode(bytes, value);}
+    void encode(ByteSink& bytes, const Value& value) const {return encoder->encode(bytes, value);}
     [[nodiscard]] size_t encoded_size(const Value& value) const {return encoder->encoded_size(value);}
     [[nodiscard]] bool fits(const Value& value) const {return encoder->fits(value);}
     [[nodiscard]] bool is_natural_encoder(const Value& value) const {return encoder->is_natural_encoder(value);}
@@ -0,0 +1,152 @@
+/*
+EncodingTemplate.cc -- addressing mode encoding compiled for constant arguments
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "EncodingTemplate.h"
+
+#include <algorithm>
+
+#include "Assembler.h"
+#include "BinaryExpression.h"
+#include "UnaryExpression.h"
+#include "VariableExpression.h"
+
+std::optional<EncodingTemplate> EncodingTemplate::compile(const Body& encoding, std::vector<Symbol> argument_names) {
+    const auto data_body = encoding.as_data();
+    if (!data_body) {
+        return {};
+    }
+
+    auto encoding_template = EncodingTemplate(std::move(argument_names));
+
+    for (const auto& datum: data_body->data) {
+        auto& compiled_datum = encoding_template.data.emplace_back();
+        compiled_datum.location = datum.expression.location();
+        compiled_datum.encoding = datum.encoding;
+        if (datum.encoding && datum.encoding->is_integer_encoder()) {
+            compiled_datum.minimum_value = datum.encoding->as_integer_encoder()->minimum_value();
+            compiled_datum.maximum_value = datum.encoding->as_integer_encoder()->maximum_value();
+        }
+        if (!encoding_template.compile(datum.expression, compiled_datum.operations, 1)) {
+            return {};
+        }
+    }
+
+    return encoding_template;
+}
+
+bool EncodingTemplate::compile(const Expression& expression, std::vector<Operation>& operations, size_t depth) { // NOLINT(misc-no-recursion)
+    stack_size = std::max(stack_size, depth);
+
+    if (const auto value = expression.value()) {
+        operations.emplace_back(*value);
+        return true;
+    }
+    else if (const auto variable = expression.as_variable()) {
+        if (variable->variable() == Assembler::symbol_opcode) {
+            operations.emplace_back(Operation::OPCODE);
+            return true;
+        }
+        else if (const auto index = argument_index(variable->variable())) {
+            operations.emplace_back(*index);
+            return true;
+        }
+        return false;
+    }
+    else if (const auto binary = expression.as_binary()) {
+        if (!compile(binary->left, operations, depth) || !compile(binary->right, operations, depth + 1)) {
+            return false;
+        }
+        operations.emplace_back(binary->operation);
+        return true;
+    }
+    else if (const auto unary = std::dynamic_pointer_cast<UnaryExpression>(expression.get_expression())) {
+        if (!compile(unary->operand, operations, depth)) {
+            return false;
+        }
+        operations.emplace_back(unary->operation);
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<size_t> EncodingTemplate::argument_index(Symbol name) const {
+    const auto it = std::ranges::find(argument_names, name);
+    if (it == argument_names.end()) {
+        return {};
+    }
+    return static_cast<size_t>(it - argument_names.begin());
+}
+
+std::optional<std::vector<DataBodyElement>> EncodingTemplate::encode(const std::vector<std::optional<Value>>& arguments, const Value& opcode) const {
+    auto stack = std::vector<Value>();
+    stack.reserve(stack_size);
+    auto elements = std::vector<DataBodyElement>();
+    elements.reserve(data.size());
+
+    for (const auto& datum: data) {
+        for (const auto& operation: datum.operations) {
+            switch (operation.type) {
+                case Operation::ARGUMENT:
+                    stack.emplace_back(*arguments[operation.argument_index]);
+                    break;
+
+                case Operation::BINARY: {
+                    auto right = stack.back();
+                    stack.pop_back();
+                    stack.back() = BinaryExpression::evaluate(stack.back(), operation.binary_operation, right);
+                    break;
+                }
+
+                case Operation::OPCODE:
+                    stack.emplace_back(opcode);
+                    break;
+
+                case Operation::UNARY:
+                    stack.back() = UnaryExpression::evaluate(operation.unary_operation, stack.back());
+                    break;
+
+                case Operation::VALUE:
+                    stack.emplace_back(operation.value);
+                    break;
+            }
+        }
+
+        auto value = stack.back();
+        stack.pop_back();
+        if (datum.minimum_value && datum.maximum_value && !(*datum.minimum_value <= value && *datum.maximum_value >= value)) {
+            return {};
+        }
+        elements.emplace_back(Expression(datum.location, value), datum.encoding);
+    }
+
+    return elements;
+}
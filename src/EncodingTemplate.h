@@ -0,0 +1,135 @@
+/*
+EncodingTemplate.h -- addressing mode encoding compiled for constant arguments
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef ENCODING_TEMPLATE_H
+#define ENCODING_TEMPLATE_H
+
+#include <optional>
+#include <vector>
+
+#include "DataBody.h"
+#include "Expression.h"
+#include "Symbol.h"
+#include "Value.h"
+
+/**
+ * Encoding of an addressing mode, compiled to evaluate directly on argument values.
+ *
+ * Used to encode instructions whose arguments are all constant without building an environment and evaluating the
+ * encoding body. Only encodings consisting of constants, arguments, `.opcode`, and unary or binary operations can be
+ * compiled.
+ */
+class EncodingTemplate {
+public:
+    /**
+     * Compile an addressing mode encoding.
+     *
+     * @param encoding The encoding of the addressing mode.
+     * @param argument_names The names of all arguments of the addressing mode.
+     * @return The compiled encoding, or no value if the encoding uses anything besides arguments and `.opcode`.
+     */
+    [[nodiscard]] static std::optional<EncodingTemplate> compile(const Body& encoding, std::vector<Symbol> argument_names);
+
+    /**
+     * Get the index of an argument in the argument values passed to `encode()`.
+     *
+     * @param name The name of the argument.
+     * @return The index of the argument, or no value if it is not an argument of the addressing mode.
+     */
+    [[nodiscard]] std::optional<size_t> argument_index(Symbol name) const;
+
+    /**
+     * Get the number of arguments.
+     *
+     * @return The number of arguments.
+     */
+    [[nodiscard]] size_t argument_count() const {return argument_names.size();}
+
+    /**
+     * Get the name of an argument.
+     *
+     * @param index The index of the argument.
+     * @return The name of the argument.
+     */
+    [[nodiscard]] Symbol argument_name(size_t index) const {return argument_names[index];}
+
+    /**
+     * Encode instruction.
+     *
+     * @param arguments The values of all arguments, in the order given by `argument_index()`.
+     * @param opcode The opcode of the instruction.
+     * @return The encoded data, or no value if a value doesn't fit its encoding.
+     */
+    [[nodiscard]] std::optional<std::vector<DataBodyElement>> encode(const std::vector<std::optional<Value>>& arguments, const Value& opcode) const;
+
+private:
+    class Operation {
+    public:
+        enum Type {
+            ARGUMENT,
+            BINARY,
+            OPCODE,
+            UNARY,
+            VALUE
+        };
+
+        explicit Operation(Type type): type{type} {}
+        explicit Operation(const Value& value): type{VALUE}, value{value} {}
+        explicit Operation(size_t argument_index): type{ARGUMENT}, argument_index{argument_index} {}
+        explicit Operation(Expression::BinaryOperation binary_operation): type{BINARY}, binary_operation{binary_operation} {}
+        explicit Operation(Expression::UnaryOperation unary_operation): type{UNARY}, unary_operation{unary_operation} {}
+
+        Type type;
+        Value value;
+        size_t argument_index{0};
+        Expression::BinaryOperation binary_operation{Expression::ADD};
+        Expression::UnaryOperation unary_operation{Expression::PLUS};
+    };
+
+    class Datum {
+    public:
+        Location location;
+        std::vector<Operation> operations; // In postfix order.
+        std::optional<Encoder> encoding;
+        std::optional<Value> minimum_value;
+        std::optional<Value> maximum_value;
+    };
+
+    explicit EncodingTemplate(std::vector<Symbol> argument_names): argument_names{std::move(argument_names)} {}
+
+    bool compile(const Expression& expression, std::vector<Operation>& operations, size_t depth);
+
+    std::vector<Symbol> argument_names;
+    std::vector<Datum> data;
+    size_t stack_size{0};
+};
+
+#endif // ENCODING_TEMPLATE_H
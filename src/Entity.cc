@@ -91,6 +91,7 @@ void Entity::process_result(EvaluationResult& result) {
     unresolved_functions = std::move(result.unresolved_functions);
     unresolved_macros = std::move(result.unresolved_macros);
     unresolved_variables = std::move(result.unresolved_variables);
+    used_symbols = std::move(result.used_symbols);
 }
 
 bool Entity::check_unresolved(Unresolved& unresolved) const {
@@ -110,19 +111,23 @@ bool Entity::check_unresolved(const std::unordered_set<Symbol>& unresolved, Unre
     return false;
 }
 
-void Entity::evaluate() {
+bool Entity::evaluate() {
+    evaluations += 1;
     auto result = EvaluationResult{};
     auto context = evaluation_context(result);
     try {
-        evaluate_inner(context);
+        auto changed = evaluate_inner(context);
         process_result(result);
+        return changed;
     } catch (Exception& ex) {
         FileReader::global.error(ParseException(location, ex));
         // TODO: throw empty expression?
+        return false;
     }
 }
 
 EvaluationResult Entity::evaluate(EvaluationContext::EvaluationType type) {
+    evaluations += 1;
     auto result = EvaluationResult{};
     try {
         auto context = evaluation_context(result, type);
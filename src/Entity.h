@@ -46,10 +46,11 @@ class Entity {
 
     [[nodiscard]] Macro* as_macro();
     [[nodiscard]] Object* as_object();
-    void evaluate();
+    virtual bool evaluate();
     [[nodiscard]] EvaluationResult evaluate(EvaluationContext::EvaluationType type);
     void resolve_labels();
     [[nodiscard]] bool check_unresolved(Unresolved& unresolved) const;
+    [[nodiscard]] bool has_unresolved() const {return !unresolved_functions.empty() || !unresolved_macros.empty() || !unresolved_variables.empty();}
     [[nodiscard]] bool is_default_only() const {return default_only;}
     [[nodiscard]] bool is_macro() {return as_macro();}
     [[nodiscard]] bool is_object() {return as_object();}
@@ -67,14 +68,16 @@ class Entity {
     std::unordered_set<Symbol> unresolved_functions;
     std::unordered_set<Symbol> unresolved_macros;
     std::unordered_set<Symbol> unresolved_variables;
+    std::unordered_set<Symbol> used_symbols;
     std::shared_ptr<Environment> environment;
+    size_t evaluations = 0; // Number of times evaluated, reported by --stats.
 
   protected:
     void serialize_entity(std::ostream& stream) const;
 
     [[nodiscard]] virtual EvaluationContext evaluation_context(EvaluationResult& result) {return EvaluationContext(result, this);}
     [[nodiscard]] virtual EvaluationContext evaluation_context(EvaluationResult& result, EvaluationContext::EvaluationType type) {return EvaluationContext(result, type, environment);}
-    virtual void evaluate_inner(EvaluationContext& context) = 0;
+    virtual bool evaluate_inner(EvaluationContext& context) = 0;
 
   private:
     [[nodiscard]] bool check_unresolved(const std::unordered_set<Symbol>& unresolved, Unresolved::Part& part) const;
@@ -31,69 +31,153 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Environment.h"
 
-std::optional<Expression> Environment::operator[](Symbol name) const { // NOLINT(misc-no-recursion)
-    auto it = variables.find(name);
-    if (it != variables.end()) {
-        return it->second;
+Environment::Environment(std::shared_ptr<Environment> next) {
+    add_next(std::move(next));
+}
+
+Environment::Environment(std::shared_ptr<const Environment> base_, std::shared_ptr<Environment> next): base(std::move(base_)) {
+    base->previous.push_back(this);
+    add_next(std::move(next));
+}
+
+Environment::Environment(const Environment& env): unnamed_labels(env.unnamed_labels), loader(env.loader), functions(env.functions), labels(env.labels), macros(env.macros), base(env.base), variables(env.variables) {
+    if (base) {
+        base->previous.push_back(this);
     }
-    for (auto& environment: next) {
-        if (auto value = (*environment)[name]) {
-            return value;
+    for (const auto& environment: env.next) {
+        add_next(environment);
+    }
+}
+
+Environment::~Environment() {
+    if (base) {
+        std::erase(base->previous, this);
+    }
+    for (const auto& environment: next) {
+        std::erase(environment->previous, this);
+    }
+}
+
+void Environment::add_next(std::shared_ptr<Environment> new_next) {
+    new_next->previous.push_back(this);
+    next.emplace_back(std::move(new_next));
+    invalidate();
+}
+
+void Environment::clear_next() {
+    for (const auto& environment: next) {
+        std::erase(environment->previous, this);
+    }
+    next.clear();
+    invalidate();
+}
+
+std::optional<Expression> Environment::get_resolved(Symbol name) const {
+    auto it = resolved.find(name);
+    if (it == resolved.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+void Environment::invalidate() const { // NOLINT(misc-no-recursion)
+    // Unless lookups went through this environment, no cache can depend on it.
+    if (!observed) {
+        return;
+    }
+    observed = false;
+
+    auto clear = [](auto& cache) {
+        if (!cache.empty()) {
+            cache.clear();
         }
+    };
+    clear(function_index);
+    clear(label_index);
+    clear(macro_index);
+    clear(variable_index);
+    clear(resolved);
+
+    for (auto environment: previous) {
+        environment->invalidate();
     }
+}
 
-    return {};
+std::optional<Expression> Environment::operator[](Symbol name) const {
+    auto value = find<Expression>(name, true, [](const Environment& environment) -> const auto& {return environment.variables;}, [](const Environment& environment) -> auto& {return environment.variable_index;});
+    if (!value) {
+        return {};
+    }
+    return *value;
 }
 
 void Environment::replace(const std::shared_ptr<Environment>& old_next, const std::shared_ptr<Environment>& new_next) {
     for (auto& environment: next) {
         if (environment == old_next) {
+            std::erase(old_next->previous, this);
+            new_next->previous.push_back(this);
             environment = new_next;
+            invalidate();
             return;
         }
     }
 }
 
-const Function* Environment::get_function(Symbol name) const { // NOLINT(misc-no-recursion)
-    auto it = functions.find(name);
+const Function* Environment::get_function(Symbol name) const {
+    auto function = find<const Function*>(name, true, [](const Environment& environment) -> const auto& {return environment.functions;}, [](const Environment& environment) -> auto& {return environment.function_index;});
+    return function ? *function : nullptr;
+}
 
-    if (it != functions.end()) {
-        return it->second;
-    }
-    for (auto& environment: next) {
-        if (auto function = environment->get_function(name)) {
-            return function;
-        }
+std::optional<SizeRange> Environment::get_label(Symbol name) const {
+    auto label = find<SizeRange>(name, false, [](const Environment& environment) -> const auto& {return environment.labels;}, [](const Environment& environment) -> auto& {return environment.label_index;});
+    if (!label) {
+        return {};
     }
-    return nullptr;
+    return *label;
 }
 
-std::optional<SizeRange> Environment::get_label(Symbol name) const { // NOLINT(misc-no-recursion)
-    auto it = labels.find(name);
+const Macro* Environment::get_macro(Symbol name) const {
+    auto macro = find<const Macro*>(name, true, [](const Environment& environment) -> const auto& {return environment.macros;}, [](const Environment& environment) -> auto& {return environment.macro_index;});
+    return macro ? *macro : nullptr;
+}
 
-    if (it != labels.end()) {
-        return it->second;
+template <typename T, typename Bindings, typename Index>
+const T* Environment::find(Symbol name, bool load, Bindings bindings, Index index) const { // NOLINT(misc-no-recursion)
+    const auto& local = bindings(*this);
+    auto it = local.find(name);
+    if (it == local.end() && load && loader && loader(name)) {
+        it = local.find(name);
     }
-    for (auto& environment: next) {
-        if (auto label = environment->get_label(name)) {
-            return label;
-        }
+    // Set after loading, which invalidates this environment.
+    observed = true;
+    if (it != local.end()) {
+        return &it->second;
     }
-    return {};
-}
-
 
-const Macro* Environment::get_macro(Symbol name) const { // NOLINT(misc-no-recursion)
-    auto it = macros.find(name);
+    if (base) {
+        const auto& shared = bindings(*base);
+        auto shared_it = shared.find(name);
+        // Changes to base invalidate this environment.
+        base->observed = true;
+        if (shared_it != shared.end()) {
+            return &shared_it->second;
+        }
+    }
 
-    if (it != macros.end()) {
-        return it->second;
+    auto& cache = index(*this);
+    auto cached = cache.find(name);
+    if (cached != cache.end()) {
+        return cached->second;
     }
+
+    const T* binding = nullptr;
     for (auto& environment: next) {
-        if (auto macro = environment->get_macro(name)) {
-            return macro;
+        if ((binding = environment->find<T>(name, load, bindings, index))) {
+            break;
         }
     }
-    return nullptr;
+    // Map elements stay in place until erased, which invalidates this cache.
+    observed = true;
+    cache[name] = binding;
+    return binding;
 }
-
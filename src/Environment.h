@@ -32,6 +32,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 
+#include <functional>
+
 #include "Expression.h"
 #include "Symbol.h"
 #include "UnnamedLabelList.h"
@@ -42,15 +44,20 @@ class Macro;
 class Environment {
 public:
     Environment() = default;
-    explicit Environment(std::shared_ptr<Environment> next): next({std::move(next)}) {}
-    Environment(const Environment& env) = default;
-
-    void add(Symbol name, Expression value) {variables[name] = std::move(value);} // TODO: check for duplicates
-    void add(Symbol name, const Function* function) {functions[name] = function;} // TODO: check for duplicates
-    void add(Symbol name, const SizeRange& offset) {labels[name] = offset;} // TODO: check for duplicates
-    void add(Symbol name, const Macro* macro) {macros[name] = macro;} // TODO: check for duplicates
-    void add_next(std::shared_ptr<Environment> new_next) {next.emplace_back(std::move(new_next));}
-    void clear_next() {next.clear();}
+    explicit Environment(std::shared_ptr<Environment> next);
+    // Sees the bindings made directly in base without copying them, but not base's next chain.
+    Environment(std::shared_ptr<const Environment> base, std::shared_ptr<Environment> next);
+    Environment(const Environment& env);
+    ~Environment();
+
+    Environment& operator=(const Environment& env) = delete;
+
+    void add(Symbol name, Expression value) {variables[name] = std::move(value); invalidate();} // TODO: check for duplicates
+    void add(Symbol name, const Function* function) {functions[name] = function; invalidate();} // TODO: check for duplicates
+    void add(Symbol name, const SizeRange& offset) {labels[name] = offset; invalidate();} // TODO: check for duplicates
+    void add(Symbol name, const Macro* macro) {macros[name] = macro; invalidate();} // TODO: check for duplicates
+    void add_next(std::shared_ptr<Environment> new_next);
+    void clear_next();
     [[nodiscard]] const std::unordered_map<Symbol, const Function*>& all_functions() const {return functions;}
     [[nodiscard]] const std::unordered_map<Symbol, SizeRange>& all_labels() const {return labels;}
     [[nodiscard]] const std::unordered_map<Symbol, const Macro*>& all_macros() const {return macros;}
@@ -60,8 +67,12 @@ public:
     [[nodiscard]] std::optional<SizeRange> get_label(Symbol name) const;
     [[nodiscard]] const Macro* get_macro(Symbol name) const;
     [[nodiscard]] std::optional<Expression> get_variable(Symbol name) const {return (*this)[name];}
-    void remove(Symbol name) {variables.erase(name);}
-    void update(Symbol name, const SizeRange& offset) {labels[name] = offset;} // TODO: check for existence
+    void remove(Symbol name) {variables.erase(name); invalidate();}
+    void update(Symbol name, const SizeRange& offset) {labels[name] = offset; invalidate();} // TODO: check for existence
+
+    // Values of variables that evaluated to constants when looked up through this environment. Cleared whenever a binding visible through it changes.
+    [[nodiscard]] std::optional<Expression> get_resolved(Symbol name) const;
+    void set_resolved(Symbol name, Expression value) const {resolved[name] = std::move(value);}
 
     std::optional<Expression> operator[](Symbol name) const;
 
@@ -69,12 +80,30 @@ public:
 
     UnnamedLabelList unnamed_labels;
 
+    // Called when a name is not defined locally, to give lazily loaded libraries a chance to provide it. Returns true if definitions were added.
+    std::function<bool(Symbol name)> loader;
+
 private:
+    template <typename T, typename Bindings, typename Index>
+    const T* find(Symbol name, bool load, Bindings bindings, Index index) const;
+    void invalidate() const;
+
     std::unordered_map<Symbol, const Function*> functions;
     std::unordered_map<Symbol, SizeRange> labels;
     std::unordered_map<Symbol, const Macro*> macros;
+    std::shared_ptr<const Environment> base; // Searched after the local bindings, before next.
     std::vector<std::shared_ptr<Environment>> next;
     std::unordered_map<Symbol, Expression> variables;
+
+    // Where names not defined locally were found in the next chain, nullptr if they weren't. Cleared whenever a binding visible through this environment changes.
+    mutable std::unordered_map<Symbol, const Function* const*> function_index;
+    mutable std::unordered_map<Symbol, const SizeRange*> label_index;
+    mutable std::unordered_map<Symbol, const Macro* const*> macro_index;
+    mutable std::unordered_map<Symbol, const Expression*> variable_index;
+    mutable std::unordered_map<Symbol, Expression> resolved;
+
+    mutable std::vector<const Environment*> previous; // Environments that have this one in next.
+    mutable bool observed = false; // Whether lookups went through this environment since it was last invalidated, so caches may depend on it.
 };
 
 
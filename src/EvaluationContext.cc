@@ -34,7 +34,10 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Entity.h"
 #include "Exception.h"
 
-EvaluationContext::EvaluationContext(EvaluationResult& result, EvaluationType type, std::shared_ptr<Environment> environment, std::unordered_set<Symbol> defines, const SizeRange& offset): type(type), environment(std::move(environment)), defines{std::move(defines)}, offset(offset), result(result) {
+EvaluationContext::EvaluationContext(EvaluationResult& result, EvaluationType type, std::shared_ptr<Environment> environment, std::unordered_set<Symbol> defines, const SizeRange& offset): type(type), environment(std::move(environment)), offset(offset), result(result) {
+    if (!defines.empty()) {
+        this->defines = std::make_shared<const std::unordered_set<Symbol>>(std::move(defines));
+    }
     if (type == MACRO_EXPANSION) {
         label_offset = SizeRange(0, {});
         labels_are_offset = true;
@@ -45,7 +48,7 @@ EvaluationContext::EvaluationContext(EvaluationResult& result, Entity* entity):
 
 EvaluationContext EvaluationContext::evaluating_variable(Symbol variable) const {
     auto new_context = *this;
-    new_context.evaluating_variables.insert(variable);
+    new_context.evaluating_variables = evaluating_variables.adding(variable);
     return new_context;
 }
 
@@ -87,7 +90,7 @@ bool EvaluationContext::shallow() const {
 
 EvaluationContext EvaluationContext::skipping_variables(const std::vector<Symbol>& variables) const {
     auto new_context = *this;
-    new_context.skip_variables.insert(variables.begin(), variables.end());
+    new_context.skip_variables = skip_variables.adding(variables);
     return new_context;
 }
 
@@ -98,6 +101,21 @@ std::optional<Expression> EvaluationContext::lookup_variable(Symbol variable) co
     return (*environment)[variable];
 }
 
+std::optional<Expression> EvaluationContext::lookup_resolved_variable(Symbol variable) const {
+    if (shallow() || !skip_variables.empty()) {
+        return {};
+    }
+    return environment->get_resolved(variable);
+}
+
+void EvaluationContext::resolved_variable(Symbol variable, const Expression& value) const {
+    // Only constants are independent of the rest of the context.
+    if (shallow() || !skip_variables.empty() || !value.has_value()) {
+        return;
+    }
+    environment->set_resolved(variable, value);
+}
+
 EvaluationContext EvaluationContext::adding_scope(std::shared_ptr<Environment> new_environment, const SizeRange& new_label_offset) const {
     auto new_context = *this;
     new_context.environment = std::move(new_environment);
@@ -37,6 +37,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Environment.h"
 #include "EvaluationResult.h"
 #include "Memory.h"
+#include "PersistentSymbolSet.h"
 #include "SizeRange.h"
 
 class Entity;
@@ -73,21 +74,24 @@ class EvaluationContext {
     [[nodiscard]] EvaluationContext keeping_label_offsets() const;
     [[nodiscard]] EvaluationContext making_conditional() const;
     [[nodiscard]] EvaluationContext adding_scope(std::shared_ptr<Environment> new_environment, const SizeRange& new_label_offset) const;
+    [[nodiscard]] bool defined(Symbol name) const {return defines && defines->contains(name);}
     [[nodiscard]] bool evaluating(Symbol variable) const {return evaluating_variables.contains(variable);}
     [[nodiscard]] bool skipping(Symbol variable) const {return skip_variables.contains(variable);}
     [[nodiscard]] std::optional<Expression> lookup_variable(Symbol variable) const;
+    [[nodiscard]] std::optional<Expression> lookup_resolved_variable(Symbol variable) const;
+    void resolved_variable(Symbol variable, const Expression& value) const;
 
     EvaluationType type;
     Entity* entity = nullptr;
     std::shared_ptr<Environment> environment;
-    std::unordered_set<Symbol> defines;
+    std::shared_ptr<const std::unordered_set<Symbol>> defines; // Shared by all derived contexts.
     SizeRange offset = SizeRange(0, {});
     SizeRange label_offset = SizeRange(0); // For preserving label offsets in macro calls.
     bool labels_are_offset = false;
     bool keep_label_offsets = false;
     bool conditional = false;
-    std::unordered_set<Symbol> skip_variables; // For preserving arguments in macro/function bodies.
-    std::unordered_set<Symbol> evaluating_variables; // Variables currently being evaluated (used for circular definition detection).
+    PersistentSymbolSet skip_variables; // For preserving arguments in macro/function bodies.
+    PersistentSymbolSet evaluating_variables; // Variables currently being evaluated (used for circular definition detection).
     EvaluationResult& result;
 };
 
@@ -0,0 +1,114 @@
+/*
+EvaluationQueue.cc --
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "EvaluationQueue.h"
+
+#include <algorithm>
+
+#include "Entity.h"
+#include "FileReader.h"
+
+// Guard against entities that report a change on every evaluation. Real dependency chains settle after a few evaluations of each entity.
+const size_t EvaluationQueue::maximum_evaluations = 32;
+
+void EvaluationQueue::add(Entity* entity) {
+    if (queued.insert(entity).second) {
+        pending.push_back(entity);
+    }
+}
+
+void EvaluationQueue::add_dependents(Symbol name) {
+    auto it = dependents.find(name);
+    if (it == dependents.end()) {
+        return;
+    }
+    for (auto entity : it->second) {
+        add(entity);
+    }
+}
+
+void EvaluationQueue::clear() {
+    pending.clear();
+    queued.clear();
+    dependents.clear();
+}
+
+void EvaluationQueue::evaluate() {
+    auto evaluations = std::unordered_map<Entity*, size_t>{};
+
+    while (!pending.empty()) {
+        auto entity = pending.front();
+        pending.pop_front();
+        queued.erase(entity);
+
+        auto count = ++evaluations[entity];
+        if (count > maximum_evaluations) {
+            if (count == maximum_evaluations + 1) {
+                FileReader::global.error(entity->location, "internal error: '%s' still changes after %zu evaluations", entity->name.c_str(), maximum_evaluations);
+            }
+            continue;
+        }
+
+        remove_dependencies(entity);
+        auto changed = entity->evaluate();
+        add_dependencies(entity);
+
+        if (changed) {
+            add(entity);
+            add_dependents(entity->name);
+        }
+    }
+}
+
+void EvaluationQueue::remove(Entity* entity) {
+    if (queued.erase(entity) > 0) {
+        std::erase(pending, entity);
+    }
+    remove_dependencies(entity);
+}
+
+void EvaluationQueue::add_dependencies(Entity* entity) {
+    for (auto symbol : entity->used_symbols) {
+        dependents[symbol].insert(entity);
+    }
+}
+
+void EvaluationQueue::remove_dependencies(Entity* entity) {
+    for (auto symbol : entity->used_symbols) {
+        auto it = dependents.find(symbol);
+        if (it != dependents.end()) {
+            it->second.erase(entity);
+            if (it->second.empty()) {
+                dependents.erase(it);
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef EVALUATION_QUEUE_H
+#define EVALUATION_QUEUE_H
+
+/*
+EvaluationQueue.h --
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Symbol.h"
+
+class Entity;
+
+/**
+ * Worklist of entities that need to be (re-)evaluated.
+ *
+ * Each entity records the symbols it looked up during its last evaluation. When an entity changes, it is evaluated
+ * again, as are all entities that used its name. Evaluation stops when no entity changes any more.
+ */
+class EvaluationQueue {
+  public:
+    void add(Entity* entity);
+    void add_dependents(Symbol name);
+    void clear();
+    [[nodiscard]] bool empty() const {return pending.empty();}
+    void evaluate();
+    void remove(Entity* entity);
+
+    static const size_t maximum_evaluations;
+
+  private:
+    void add_dependencies(Entity* entity);
+    void remove_dependencies(Entity* entity);
+
+    std::deque<Entity*> pending;
+    std::unordered_set<Entity*> queued;
+    std::unordered_map<Symbol, std::unordered_set<Entity*>> dependents;
+};
+
+#endif // EVALUATION_QUEUE_H
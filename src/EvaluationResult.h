@@ -33,6 +33,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define EVALUATION_RESULT_H
 
 #include <unordered_set>
+#include <vector>
 
 #include "ChecksumComputation.h"
 #include "Symbol.h"
@@ -49,12 +50,14 @@ public:
     void add_unresolved_function(Symbol name) {unresolved_functions.insert(name);}
     void add_unresolved_macro(Symbol name) {unresolved_macros.insert(name);}
     void add_unresolved_variable(Symbol name) {unresolved_variables.insert(name);}
+    void add_used_symbol(Symbol name) {used_symbols.insert(name);}
 
     uint64_t next_unnamed_label{1};
     std::unordered_set<Symbol> unresolved_functions;
     std::unordered_set<Symbol> unresolved_macros;
     std::unordered_set<Symbol> unresolved_variables;
     std::unordered_set<Object*> used_objects;
+    std::unordered_set<Symbol> used_symbols; // Names looked up, whether found or not (used for dependency tracking).
     UsedEntities used_entites;
     std::vector<ChecksumComputation> checksums;
 };
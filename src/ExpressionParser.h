@@ -32,7 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef EXPRESSION_PARSER_H
 #define EXPRESSION_PARSER_H
 
-
+#include <mutex>
 
 #include "DataBody.h"
 #include "Encoder.h"
@@ -125,7 +125,7 @@ private:
 
     static std::unordered_map<Token, BinaryOperator> binary_operators;
     static std::unordered_map<Token, Expression::UnaryOperation> unary_operators;
-    static bool initialized;
+    static std::once_flag initialized;
 };
 
 
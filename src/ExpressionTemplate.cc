@@ -0,0 +1,109 @@
+/*
+ExpressionTemplate.cc -- expression compiled for constant arguments
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "ExpressionTemplate.h"
+
+#include <algorithm>
+
+#include "BinaryExpression.h"
+#include "UnaryExpression.h"
+#include "VariableExpression.h"
+
+std::optional<ExpressionTemplate> ExpressionTemplate::compile(const Expression& expression, const std::vector<Symbol>& argument_names) {
+    auto expression_template = ExpressionTemplate();
+    if (!expression_template.compile(expression, argument_names, 1)) {
+        return {};
+    }
+    return expression_template;
+}
+
+bool ExpressionTemplate::compile(const Expression& expression, const std::vector<Symbol>& argument_names, size_t depth) { // NOLINT(misc-no-recursion)
+    stack_size = std::max(stack_size, depth);
+
+    if (const auto value = expression.value()) {
+        operations.emplace_back(*value);
+        return true;
+    }
+    else if (const auto variable = expression.as_variable()) {
+        const auto it = std::ranges::find(argument_names, variable->variable());
+        if (it == argument_names.end()) {
+            return false;
+        }
+        operations.emplace_back(static_cast<size_t>(it - argument_names.begin()));
+        return true;
+    }
+    else if (const auto binary = expression.as_binary()) {
+        if (!compile(binary->left, argument_names, depth) || !compile(binary->right, argument_names, depth + 1)) {
+            return false;
+        }
+        operations.emplace_back(binary->operation);
+        return true;
+    }
+    else if (const auto unary = std::dynamic_pointer_cast<UnaryExpression>(expression.get_expression())) {
+        if (!compile(unary->operand, argument_names, depth)) {
+            return false;
+        }
+        operations.emplace_back(unary->operation);
+        return true;
+    }
+
+    return false;
+}
+
+Value ExpressionTemplate::evaluate(const std::vector<Value>& arguments) const {
+    auto stack = std::vector<Value>();
+    stack.reserve(stack_size);
+
+    for (const auto& operation: operations) {
+        switch (operation.type) {
+            case Operation::ARGUMENT:
+                stack.emplace_back(arguments[operation.argument_index]);
+                break;
+
+            case Operation::BINARY: {
+                auto right = stack.back();
+                stack.pop_back();
+                stack.back() = BinaryExpression::evaluate(stack.back(), operation.binary_operation, right);
+                break;
+            }
+
+            case Operation::UNARY:
+                stack.back() = UnaryExpression::evaluate(operation.unary_operation, stack.back());
+                break;
+
+            case Operation::VALUE:
+                stack.emplace_back(operation.value);
+                break;
+        }
+    }
+
+    return stack.back();
+}
@@ -0,0 +1,97 @@
+/*
+ExpressionTemplate.h -- expression compiled for constant arguments
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef EXPRESSION_TEMPLATE_H
+#define EXPRESSION_TEMPLATE_H
+
+#include <optional>
+#include <vector>
+
+#include "Expression.h"
+#include "Symbol.h"
+#include "Value.h"
+
+/**
+ * Expression compiled to evaluate directly on argument values.
+ *
+ * Used to call functions whose arguments are all constant without building an environment and evaluating the
+ * definition. Only expressions consisting of constants, arguments, and unary or binary operations can be compiled.
+ */
+class ExpressionTemplate {
+public:
+    /**
+     * Compile an expression.
+     *
+     * @param expression The expression to compile.
+     * @param argument_names The names of all arguments.
+     * @return The compiled expression, or no value if the expression uses anything besides constants and arguments.
+     */
+    [[nodiscard]] static std::optional<ExpressionTemplate> compile(const Expression& expression, const std::vector<Symbol>& argument_names);
+
+    /**
+     * Evaluate expression.
+     *
+     * @param arguments The values of all arguments, in the order given to `compile()`.
+     * @return The value of the expression.
+     */
+    [[nodiscard]] Value evaluate(const std::vector<Value>& arguments) const;
+
+private:
+    class Operation {
+    public:
+        enum Type {
+            ARGUMENT,
+            BINARY,
+            UNARY,
+            VALUE
+        };
+
+        explicit Operation(const Value& value): type{VALUE}, value{value} {}
+        explicit Operation(size_t argument_index): type{ARGUMENT}, argument_index{argument_index} {}
+        explicit Operation(Expression::BinaryOperation binary_operation): type{BINARY}, binary_operation{binary_operation} {}
+        explicit Operation(Expression::UnaryOperation unary_operation): type{UNARY}, unary_operation{unary_operation} {}
+
+        Type type;
+        Value value;
+        size_t argument_index{0};
+        Expression::BinaryOperation binary_operation{Expression::ADD};
+        Expression::UnaryOperation unary_operation{Expression::PLUS};
+    };
+
+    ExpressionTemplate() = default;
+
+    bool compile(const Expression& expression, const std::vector<Symbol>& argument_names, size_t depth);
+
+    std::vector<Operation> operations; // In postfix order.
+    size_t stack_size{0};
+};
+
+#endif // EXPRESSION_TEMPLATE_H
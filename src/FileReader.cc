@@ -34,65 +34,113 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <algorithm>
 #include <cstring>
 
+#include "MappedFile.h"
 #include "ParseException.h"
 #include "Util.h"
 
-#include <fstream>
-
 FileReader FileReader::global;
 
-std::vector<std::string> FileReader::empty_file;
+thread_local std::ostream* FileReader::thread_diagnostics_file = nullptr;
+thread_local FileReader::Recording* FileReader::current_recording = nullptr;
+
+FileReader::Recording::~Recording() {
+    current_recording = outer;
+    if (outer) {
+        outer->files.insert(outer->files.end(), files.begin(), files.end());
+    }
+}
 
-const std::vector<std::string>& FileReader::read(Symbol file_name, bool optional) {
+Blob FileReader::read(Symbol file_name, bool optional) {
+    if (current_recording) {
+        current_recording->files.emplace_back(file_name);
+    }
+    auto lock = std::lock_guard(mutex);
     const auto it = files.find(file_name);
     if (it != files.end()) {
-        return it->second;
+        return it->second.contents;
     }
 
-    std::ifstream input_file(file_name.str());
-    if (input_file) {
-        std::vector<std::string> lines;
-        std::string s;
-        while (getline(input_file, s)) {
-            lines.push_back(s);
-        }
-
-        files[file_name] = std::move(lines);
-        return files[file_name];
+    if (optional && !std::filesystem::exists(file_name.str())) {
+        return {};
     }
-    else if (errno == EEXIST && optional) {
-        return empty_file;
+
+    try {
+        auto file = std::make_shared<const MappedFile>(file_name);
+        auto contents = Blob(file, file->contents());
+        files.emplace(file_name, TextFile(contents));
+        return contents;
     }
-    else {
+    catch (...) {
         error_flag = true;
-        throw Exception("can't open '%s': %s", file_name.c_str(), strerror(errno));
+        throw;
     }
 }
 
-std::string FileReader::read_binary(Symbol file_name) {
-    if (std::ifstream input_file{file_name.str()}) {
-        return std::string{std::istreambuf_iterator<char>{input_file}, {}};
+Blob FileReader::read_binary(Symbol file_name) {
+    if (current_recording) {
+        current_recording->files.emplace_back(file_name);
     }
-    else {
+    auto lock = std::lock_guard(mutex);
+    auto error = std::error_code();
+    auto modification_time = std::filesystem::last_write_time(file_name.str(), error);
+    if (error) {
+        error_flag = true;
+        throw Exception("can't open '%s': %s", file_name.c_str(), error.message().c_str());
+    }
+
+    const auto it = binary_files.find(file_name);
+    if (it != binary_files.end() && it->second.modification_time == modification_time) {
+        return it->second.contents;
+    }
+
+    try {
+        auto file = std::make_shared<const MappedFile>(file_name);
+        auto contents = Blob(file, file->contents());
+        binary_files[file_name] = BinaryFile{modification_time, contents};
+        return contents;
+    }
+    catch (...) {
         error_flag = true;
-        throw Exception("can't open '%s': %s", file_name.c_str(), strerror(errno));
+        throw;
     }
 }
 
-const std::string &FileReader::get_line(Symbol file, size_t line_number) const {
+std::string_view FileReader::get_line(Symbol file, size_t line_number) const {
+    auto lock = std::lock_guard(mutex);
     const auto it = files.find(file);
 
     if (it == files.end()) {
         throw Exception("unknown file '%s'",file.c_str());
     }
 
-    if (line_number == 0 || line_number > it->second.size()) {
+    auto line = it->second.line(line_number);
+    if (!line) {
         throw Exception("line integer %zu out of range in '%s'", line_number, file.c_str());
     }
 
-    return it->second[line_number - 1];
+    return *line;
 }
 
+std::optional<std::string_view> FileReader::TextFile::line(size_t line_number) const {
+    const auto text = contents.view();
+
+    if (line_starts.empty() && !text.empty()) {
+        line_starts.emplace_back(0);
+        for (size_t position = 0; position < text.size() - 1; position++) {
+            if (text[position] == '\n') {
+                line_starts.emplace_back(position + 1);
+            }
+        }
+    }
+
+    if (line_number == 0 || line_number > line_starts.size()) {
+        return {};
+    }
+
+    auto start = line_starts[line_number - 1];
+    auto end = text.find('\n', start);
+    return text.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+}
 
 const char* FileReader::diagnostics_severity_name(DiagnosticsSeverity severity) {
     switch (severity) {
@@ -146,38 +194,41 @@ void FileReader::output(FileReader::DiagnosticsSeverity severity, const Location
 }
 
 void FileReader::output(FileReader::DiagnosticsSeverity severity, const Location &location, const std::string &message) const {
+    auto lock = std::lock_guard(mutex);
+    auto& stream = thread_diagnostics_file ? *thread_diagnostics_file : diagnostics_file;
     const auto location_string = location.to_string();
     if (!location_string.empty()) {
-        diagnostics_file << location_string << ": ";
+        stream << location_string << ": ";
     }
-    diagnostics_file << diagnostics_severity_name(severity) << ": " << message << std::endl;
+    stream << diagnostics_severity_name(severity) << ": " << message << std::endl;
 
     try {
         const auto& line = get_line(location.file, location.start_line_number);
-        diagnostics_file << line << std::endl;
+        stream << line << std::endl;
         auto width = location.end_column - location.start_column;
         if (width < 1) {
             width = 1;
         }
         for (size_t i = 0; i < location.start_column; i++) {
-            diagnostics_file << ' ';
+            stream << ' ';
         }
         for (size_t i = 0; i < width; i++) {
-            diagnostics_file << '^';
+            stream << '^';
         }
-        diagnostics_file << std::endl;
+        stream << std::endl;
     }
     catch (...) {}
 }
 
 std::vector<std::string> FileReader::file_names() const {
+    auto lock = std::lock_guard(mutex);
     auto file_names = std::vector<std::string>();
 
     for (const auto& pair: files) {
         file_names.emplace_back(pair.first.str());
     }
-    for (const auto& name: binary_files) {
-        file_names.emplace_back(name.str());
+    for (const auto& pair: binary_files) {
+        file_names.emplace_back(pair.first.str());
     }
 
     std::sort(file_names.begin(), file_names.end());
@@ -32,12 +32,18 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef FILEREADER_H
 #define FILEREADER_H
 
+#include <atomic>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "Blob.h"
 #include "Exception.h"
 #include "Location.h"
 #include "Symbol.h"
@@ -51,10 +57,10 @@ public:
         ERROR
     };
 
-    const std::vector<std::string>& read(Symbol file_name, bool optional = false);
-    std::string read_binary(Symbol file_name);
+    Blob read(Symbol file_name, bool optional = false);
+    Blob read_binary(Symbol file_name);
 
-    [[nodiscard]] const std::string& get_line(Symbol file, size_t line_number) const;
+    [[nodiscard]] std::string_view get_line(Symbol file, size_t line_number) const;
 
     void notice(const Location& location, const char* format, ...) const PRINTF_LIKE(3, 4);
     void notice(const Location& location, const std::string& message) const {output(NOTICE, location, message);}
@@ -71,6 +77,23 @@ public:
 
     [[nodiscard]] bool had_error() const {return error_flag;}
 
+    // Send diagnostics issued by the calling thread to stream instead, or restore the default if stream is nullptr.
+    static void redirect_thread_diagnostics(std::ostream* stream) {thread_diagnostics_file = stream;}
+
+    // Collects the names of files read by the calling thread while it exists. Files are also added to enclosing recordings.
+    class Recording {
+    public:
+        Recording(): outer{current_recording} {current_recording = this;}
+        ~Recording();
+        Recording(const Recording&) = delete;
+        Recording& operator=(const Recording&) = delete;
+
+        std::vector<Symbol> files;
+
+    private:
+        Recording* outer;
+    };
+
     static FileReader global;
 
     bool verbose_error_messages{false};
@@ -78,12 +101,31 @@ public:
 private:
     static const char *diagnostics_severity_name(DiagnosticsSeverity severity);
 
-    static std::vector<std::string> empty_file;
+    class BinaryFile {
+    public:
+        std::filesystem::file_time_type modification_time;
+        Blob contents;
+    };
+
+    class TextFile {
+    public:
+        explicit TextFile(Blob contents): contents{std::move(contents)} {}
+
+        [[nodiscard]] std::optional<std::string_view> line(size_t line_number) const;
+
+        Blob contents;
+
+    private:
+        mutable std::vector<size_t> line_starts; // Built on first use, only needed for diagnostics.
+    };
 
-    std::unordered_set<Symbol> binary_files;
-    std::unordered_map<Symbol,std::vector<std::string>> files;
-    bool error_flag = false;
+    std::unordered_map<Symbol, BinaryFile> binary_files; // Memory mapped, shared by all values referencing them.
+    std::unordered_map<Symbol, TextFile> files; // Memory mapped, shared by all tokenizers reading them.
+    std::atomic<bool> error_flag = false;
     std::ostream& diagnostics_file = std::cerr;
+    static thread_local std::ostream* thread_diagnostics_file;
+    static thread_local Recording* current_recording;
+    mutable std::recursive_mutex mutex; // Files are read and diagnostics issued by all threads assembling files.
 
 };
 
@@ -32,6 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileTokenizer.h"
 
 #include <algorithm>
+#include <limits>
 #include <ranges>
 
 #include "ExpressionParser.h"
@@ -74,11 +75,14 @@ FileTokenizer::FileTokenizer(const Path& path, const Target* target, bool use_pr
 }
 
 void FileTokenizer::push(Symbol file_name) {
-    const auto& lines = FileReader::global.read(file_name);
-    if (lines.empty()) {
+    push(file_name, FileReader::global.read(file_name));
+}
+
+void FileTokenizer::push(Symbol file_name, Blob contents) {
+    if (contents.empty()) {
         return;
     }
-    sources.emplace_back(file_name, lines);
+    sources.emplace_back(file_name, std::move(contents));
     current_source = &sources[sources.size() - 1];
 }
 
@@ -148,31 +152,27 @@ Token FileTokenizer::next_raw() {
     while (true) {
         auto location = current_source->location();
 
-        auto c = current_source->next();
-        if (c == '{') {
-            auto c2 = current_source->next();
-            if (c2 == '{') {
+        if (!current_source->at_end()) {
+            auto text = current_source->rest();
+            if (text.starts_with("{{")) {
+                current_source->skip(2);
                 return parse_hex(location);
             }
-            else {
-                current_source->unget();
-                current_source->unget();
-            }
-        }
-        else {
-            current_source->unget();
-        }
 
-        std::string name;
-        if (auto type = matcher.match(*current_source, name)) {
-            current_source->expand_location(location);
-            last_was_newline = false;
-            return {*type, location, name};
+            if (!compiled_literals) {
+                compiled_literals = literals();
+            }
+            size_t length;
+            Symbol name;
+            if (auto type = compiled_literals->table.match(text, length, name)) {
+                current_source->skip(length);
+                current_source->expand_location(location);
+                last_was_newline = false;
+                return {*type, location, name};
+            }
         }
 
-        current_source->reset_to(location);
-
-        c = current_source->next();
+        auto c = current_source->next();
 
         if (c == EOF) {
             eof_location = current_location();
@@ -405,7 +405,8 @@ Token FileTokenizer::parse_char(Location location) {
     }
 
     auto bytes = std::string{};
-    encoding->encode(bytes, value);
+    auto sink = ByteSink(bytes);
+    encoding->encode(sink, value);
     if (bytes.empty()) {
         throw ParseException(location, "empty character constant");
     }
@@ -582,88 +583,30 @@ void FileTokenizer::define(const std::unordered_set<Symbol>& defines) {
 }
 
 int FileTokenizer::Source::next() {
-    if (line >= lines.size()) {
+    if (position >= end) {
         return EOF;
     }
 
-    if (column >= lines[line].size()) {
+    auto c = position < text.size() ? text[position] : '\n';
+    position += 1;
+    if (c == '\n') {
         line += 1;
-        column = 0;
-        return '\n';
+        line_start = position;
     }
-
-    auto c = lines[line][column];
-    column += 1;
     return c;
 }
 
 void FileTokenizer::Source::unget() {
-    if (column == 0) {
-        if (line > 0) {
-            line -= 1;
-            column = lines[line].size();
-        }
-    }
-    else {
-        column -= 1;
-    }
-}
-
-void FileTokenizer::Source::reset_to(const Location& new_location) {
-    if (new_location.file != file_) {
-        throw ParseException(location(), "can't reset to new_location in different file");
-    }
-    line = new_location.start_line_number - 1;
-    column = new_location.start_column;
-}
-
-std::optional<Token::Type> FileTokenizer::MatcherNode::match(FileTokenizer::Source& source, std::string& name) { // NOLINT(misc-no-recursion)
-    auto c = source.next();
-    if (c == EOF) {
-        if (name.empty()) {
-            // don't match empty string
-            return {};
-        }
-        return match_type;
+    if (position == 0) {
+        return;
     }
 
-    auto it = next.find(static_cast<char>(c));
-
-    if (it == next.end()) {
-        while (suffix_characters.contains(static_cast<char>(c))) {
-            name += static_cast<char>(c);
-            c = source.next();
-            if (c == EOF) {
-                break;
-            }
-        }
-
-        bool matched;
-
-        if (name.empty() || !match_type.has_value()) {
-            // don't match empty string
-            matched = false;
-        }
-        else if (!match_in_word && is_identifier_continuation(c)) {
-            // don't match prefix of longer identifier (if matched string is valid identifier)
-            matched = !is_identifier(name);
-        }
-        else {
-            // match if next character can't be part of identifier, or we're matching inside longer identifiers.
-            matched = true;
-        }
-
-        if (matched) {
-            source.unget();
-            return match_type;
-        }
-        else {
-            return {};
-        }
+    position -= 1;
+    if (position >= text.size() || text[position] == '\n') {
+        line -= 1;
+        auto previous_newline = position == 0 ? std::string_view::npos : text.rfind('\n', position - 1);
+        line_start = previous_newline == std::string_view::npos ? 0 : previous_newline + 1;
     }
-
-    name += static_cast<char>(c);
-    return it->second->match(source, name);
 }
 
 void FileTokenizer::MatcherNode::add(const char* string, Token::Type type, const std::unordered_set<char>& new_suffix, bool match_in_word_) { // NOLINT(misc-no-recursion)
@@ -697,6 +640,96 @@ bool FileTokenizer::MatcherNode::conflicts(const std::unordered_set<char>& new_s
     return std::ranges::any_of(new_suffix, [this](char c) { return next.contains(c); });
 }
 
+FileTokenizer::MatcherTable::MatcherTable(const MatcherNode& root) {
+    auto used = std::bitset<256>();
+    auto collect = [&used](const MatcherNode& node, auto& collect_ref) -> void { // NOLINT(misc-no-recursion)
+        for (const auto& [c, next] : node.next) {
+            used.set(static_cast<unsigned char>(c));
+            collect_ref(*next, collect_ref);
+        }
+    };
+    collect(root, collect);
+
+    for (size_t c = 0; c < used.size(); c++) {
+        if (used[c]) {
+            character_class[c] = static_cast<uint8_t>(class_count);
+            class_count += 1;
+        }
+    }
+
+    add_state(root, "");
+}
+
+size_t FileTokenizer::MatcherTable::add_state(const MatcherNode& node, const std::string& name) { // NOLINT(misc-no-recursion)
+    auto index = states.size();
+    if (index > std::numeric_limits<uint16_t>::max()) {
+        throw Exception("too many literals");
+    }
+
+    auto& state = states.emplace_back();
+    state.match_type = node.match_type;
+    state.match_in_word = node.match_in_word;
+    state.is_identifier = is_identifier(name);
+    state.has_suffix_characters = !node.suffix_characters.empty();
+    for (auto c : node.suffix_characters) {
+        state.suffix_characters.set(static_cast<unsigned char>(c));
+    }
+    if (node.match_type) {
+        state.name = Symbol(name);
+    }
+    transitions.resize(transitions.size() + class_count);
+
+    for (const auto& [c, next] : node.next) {
+        auto next_index = add_state(*next, name + c);
+        transitions[index * class_count + character_class[static_cast<unsigned char>(c)]] = static_cast<uint16_t>(next_index);
+    }
+
+    return index;
+}
+
+std::optional<Token::Type> FileTokenizer::MatcherTable::match(std::string_view text, size_t& length, Symbol& name) const {
+    size_t state_index = 0;
+    size_t position = 0;
+
+    while (position < text.size()) {
+        auto next = next_state(state_index, text[position]);
+        if (next == 0) {
+            break;
+        }
+        state_index = next;
+        position += 1;
+    }
+
+    const auto& state = states[state_index];
+    auto literal_length = position;
+    if (state.has_suffix_characters) {
+        while (position < text.size() && state.suffix_characters[static_cast<unsigned char>(text[position])]) {
+            position += 1;
+        }
+    }
+
+    if (position == 0 || !state.match_type) {
+        // don't match empty string
+        return {};
+    }
+
+    if (!state.match_in_word && position < text.size() && is_identifier_continuation(static_cast<unsigned char>(text[position]))) {
+        // don't match prefix of longer identifier (if matched string is valid identifier)
+        if (position == literal_length ? state.is_identifier : is_identifier(std::string(text.substr(0, position)))) {
+            return {};
+        }
+    }
+
+    length = position;
+    if (position == literal_length) {
+        name = state.name;
+    }
+    else {
+        name = Symbol(text.substr(0, position));
+    }
+    return state.match_type;
+}
+
 void FileTokenizer::PreprocessorDirective::operator()(FileTokenizer& tokenizer, const Token& directive, const std::vector<Token>& arguments) const {
     if (min_arguments && arguments.size() < min_arguments) {
         throw ParseException(directive, "too few arguments to '%s'", directive.as_string().c_str());
@@ -714,9 +747,38 @@ void FileTokenizer::PreprocessorDirective::operator()(FileTokenizer& tokenizer,
 }
 
 void FileTokenizer::add_literal(Token::Type match, const std::string& name, const std::string& suffix_characters) {
+    if (using_shared_literals) {
+        literal_list = compiled_literals->literals;
+        matcher = MatcherNode();
+        for (const auto& literal : literal_list) {
+            add_to_matcher(literal);
+        }
+        using_shared_literals = false;
+    }
+    auto literal = Literal{match, name, suffix_characters};
+    add_to_matcher(literal);
+    literal_list.emplace_back(std::move(literal));
+    compiled_literals.reset();
+}
+
+void FileTokenizer::add_to_matcher(const Literal& literal) {
     auto suffix_set = std::unordered_set<char>();
-    for (auto c : suffix_characters) {
+    for (auto c : literal.suffix_characters) {
         suffix_set.insert(c);
     }
-    matcher.add(name.c_str(), match, suffix_set);
+    matcher.add(literal.name.c_str(), literal.type, suffix_set);
+}
+
+std::shared_ptr<const FileTokenizer::Literals> FileTokenizer::literals() {
+    if (!compiled_literals) {
+        compiled_literals = std::make_shared<const Literals>(literal_list, matcher);
+    }
+    return compiled_literals;
+}
+
+void FileTokenizer::set_literals(std::shared_ptr<const Literals> new_literals) {
+    compiled_literals = std::move(new_literals);
+    literal_list.clear();
+    matcher = MatcherNode();
+    using_shared_literals = true;
 }
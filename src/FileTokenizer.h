@@ -32,10 +32,15 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef FILE_TOKENIZER_H
 #define FILE_TOKENIZER_H
 
+#include <array>
+#include <bitset>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "Blob.h"
 #include "Tokenizer.h"
 #include "Token.h"
 #include "Location.h"
@@ -47,6 +52,7 @@ class FileTokenizer: public Tokenizer {
 public:
     explicit FileTokenizer(const Path& path = Path::empty_path, const Target* target = {}, bool use_preprocessor = true, const std::unordered_set<Symbol>& defines = {});
     void push(Symbol filename);
+    void push(Symbol filename, Blob contents);
 
     [[nodiscard]] Location current_location() const override;
     [[nodiscard]] Symbol current_file() const {return current_source ? current_source->file() : Symbol();}
@@ -57,10 +63,23 @@ public:
     void undefine(Symbol name) {defines.erase(name);}
     void set_target(const Target* new_target) {target = new_target;}
 
+    class Literal {
+    public:
+        Token::Type type;
+        std::string name;
+        std::string suffix_characters;
+    };
+    class Literals;
+
     void add_punctuations(const std::unordered_set<std::string>& names);
     void add_literal(const Token& token) { add_literal(token.get_type(), token.as_string());}
     void add_literal(Token::Type match, const std::string& name, const std::string& suffix_characters = "");
 
+    // Literals added so far, compiled into a matcher table. The result is immutable and can be shared between tokenizers.
+    [[nodiscard]] std::shared_ptr<const Literals> literals();
+    // Replace all literals with shared ones. Adding a literal afterwards copies them.
+    void set_literals(std::shared_ptr<const Literals> new_literals);
+
     std::unordered_set<Symbol> defines;
 
 protected:
@@ -85,24 +104,30 @@ private:
     };
     class Source {
     public:
-        Source(Symbol file, const std::vector<std::string>& lines) : file_(file), lines(lines) {}
+        Source(Symbol file, Blob contents) : file_(file), contents(std::move(contents)), text(this->contents.view()), end(text.size() + (text.ends_with('\n') ? 0 : 1)) {}
 
         int next();
         void unget();
+        [[nodiscard]] bool at_end() const {return position >= text.size();}
+        [[nodiscard]] std::string_view rest() const {return text.substr(position);}
+        void skip(size_t length) {position += length;} // Skipped characters must not include newlines.
 
         [[nodiscard]] Symbol file() const {return file_;}
-        [[nodiscard]] Location location() const { return {file(), line + 1, column, column}; }
-        void expand_location(Location& location) const { location.end_column = column; }
-
-        void reset_to(const Location& new_location);
+        [[nodiscard]] Location location() const { return {file(), line + 1, column(), column()}; }
+        void expand_location(Location& location) const { location.end_column = column(); }
 
         std::vector<PreState> pre_states;
 
     private:
+        [[nodiscard]] size_t column() const {return position - line_start;}
+
         Symbol file_;
-        const std::vector<std::string>& lines;
+        Blob contents;
+        std::string_view text;
+        size_t end; // Includes an implicit newline if the file doesn't end with one.
+        size_t position = 0;
         size_t line = 0;
-        size_t column = 0;
+        size_t line_start = 0;
     };
 
     class MatcherNode {
@@ -113,12 +138,38 @@ private:
         std::unordered_set<char> suffix_characters;
 
         void add(const char* string, Token::Type type, const std::unordered_set<char>& suffix_characters = {}, bool match_in_word = false);
-        std::optional<Token::Type> match(Source& source, std::string& name);
 
       private:
         [[nodiscard]] bool conflicts(const std::unordered_set<char>& new_suffix) const;
     };
 
+    // Dense transition table compiled from the MatcherNode trie. Characters are mapped to equivalence classes, so each state has one row with an entry per class.
+    class MatcherTable {
+    public:
+        explicit MatcherTable(const MatcherNode& root);
+
+        // Match literal at beginning of text, which is the rest of the source. On success, sets length to number of characters matched.
+        std::optional<Token::Type> match(std::string_view text, size_t& length, Symbol& name) const;
+
+    private:
+        struct State {
+            std::optional<Token::Type> match_type;
+            bool match_in_word = false;
+            bool is_identifier = false;
+            bool has_suffix_characters = false;
+            std::bitset<256> suffix_characters;
+            Symbol name;
+        };
+
+        size_t add_state(const MatcherNode& node, const std::string& name);
+        [[nodiscard]] uint16_t next_state(size_t state, char c) const {return transitions[state * class_count + character_class[static_cast<unsigned char>(c)]];}
+
+        std::array<uint8_t, 256> character_class{};
+        size_t class_count = 1;
+        std::vector<State> states;
+        std::vector<uint16_t> transitions; // 0 means no transition, since the start state can't be reached again.
+    };
+
     class PreprocessorDirective {
     public:
         PreprocessorDirective(std::optional<size_t> min_arguments, std::optional<size_t> max_arguments, std::vector<TokenGroup> argument_type,void (FileTokenizer::*handler)(const Token&, const std::vector<Token>&)): min_arguments{min_arguments}, max_arguments{max_arguments}, argument_type{std::move(argument_type)}, handler{handler} {}
@@ -168,7 +219,12 @@ private:
     static const Token token_undefine;
     static const std::unordered_map<Token, PreprocessorDirective> preprocessor_directives;
 
+    void add_to_matcher(const Literal& literal);
+
     MatcherNode matcher;
+    std::vector<Literal> literal_list; // Literals in matcher, empty while using shared literals.
+    bool using_shared_literals{false};
+    std::shared_ptr<const Literals> compiled_literals; // Reset when a literal is added.
 
     std::vector<Source> sources;
     Source* current_source{};
@@ -177,4 +233,12 @@ private:
     bool last_was_newline{true};
 };
 
+class FileTokenizer::Literals {
+public:
+    Literals(std::vector<Literal> literals, const MatcherNode& matcher): literals(std::move(literals)), table(matcher) {}
+
+    std::vector<Literal> literals;
+    MatcherTable table;
+};
+
 #endif // FILE_TOKENIZER_H
@@ -52,7 +52,8 @@ Expression FillExpression::create(const Location& location, const Expression& co
         const auto real_value = *value.value();
         auto encoding = Encoder(real_value);
         auto bytes = std::string{};
-        encoding.encode(bytes, real_value);
+        auto sink = ByteSink(bytes);
+        encoding.encode(sink, real_value);
         auto result = std::string{};
         result.reserve(actual_count * bytes.size());
         for (uint64_t i = 0; i < actual_count; i++) {
@@ -35,14 +35,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define DEFINITION "definition"
 
-bool Function::initialized = false;
+std::once_flag Function::initialized;
 Token Function::token_definition;
 
 void Function::initialize() {
-    if (!initialized) {
-        initialized = true;
+    std::call_once(initialized, [] {
         token_definition = Token(Token::NAME, DEFINITION);
-    }
+    });
 }
 
 Function::Function(ObjectFile* owner, const Token& name, const std::shared_ptr<ParsedValue>& definition_) : Callable(owner, name, definition_) {
@@ -63,9 +62,56 @@ std::ostream& operator<<(std::ostream& stream, const Function& function) {
 
 
 Expression Function::call(const Location& location, const std::vector<Expression>& arguments) const {
+    auto key = constant_arguments(arguments);
+    if (key) {
+        auto it = results.find(*key);
+        if (it != results.end()) {
+            return it->second;
+        }
+        if (auto value = call_compiled(*key)) {
+            return results.emplace(std::move(*key), Expression(definition.location(), *value)).first->second;
+        }
+    }
+
     EvaluationResult result;
     // TODO: use location
-    return definition.evaluated(EvaluationContext(result, EvaluationContext::ARGUMENTS, bind(arguments))).value_or(definition);
+    auto value = definition.evaluated(EvaluationContext(result, EvaluationContext::ARGUMENTS, bind(arguments))).value_or(definition);
+    if (key) {
+        results.emplace(std::move(*key), value);
+    }
+    return value;
+}
+
+
+std::optional<Value> Function::call_compiled(const std::vector<Value>& actual_arguments) const {
+    if (!definition_compiled) {
+        definition_template = ExpressionTemplate::compile(definition, arguments.names);
+        definition_compiled = true;
+    }
+    if (!definition_template || actual_arguments.size() < arguments.minimum_arguments() || actual_arguments.size() > arguments.maximum_arguments()) {
+        return {};
+    }
+
+    auto values = actual_arguments;
+    for (auto index = values.size(); index < arguments.maximum_arguments(); index++) {
+        auto argument = default_argument(index);
+        if (!argument->has_value()) {
+            return {};
+        }
+        values.emplace_back(*argument->value());
+    }
+    return definition_template->evaluate(values);
+}
+
+
+bool Function::evaluate_inner(EvaluationContext& context) {
+    if (!definition.evaluate(context)) {
+        return false;
+    }
+    results.clear();
+    definition_template.reset();
+    definition_compiled = false;
+    return true;
 }
 
 
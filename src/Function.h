@@ -32,7 +32,11 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef FUNCTION_H
 #define FUNCTION_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include "Callable.h"
+#include "ExpressionTemplate.h"
 
 class Function: public Callable {
   public:
@@ -44,12 +48,22 @@ class Function: public Callable {
     Expression definition;
 
   protected:
-    void evaluate_inner(EvaluationContext &context) override {definition.evaluate(context);}
+    bool evaluate_inner(EvaluationContext &context) override;
 
   private:
+    [[nodiscard]] std::optional<Value> call_compiled(const std::vector<Value>& actual_arguments) const;
+
     static void initialize();
 
-    static bool initialized;
+    // These caches are not locked: functions are only called while evaluating, which is done by the thread assembling their file, or while linking, which is sequential.
+
+    // Results of calls, by constant argument values. Cleared when definition changes.
+    mutable std::unordered_map<std::vector<Value>, Expression, ArgumentsHash, ArgumentsEqual> results;
+    // Definition compiled for constant arguments, if possible. Compiled on first use after definition changes.
+    mutable std::optional<ExpressionTemplate> definition_template;
+    mutable bool definition_compiled = false;
+
+    static std::once_flag initialized;
     static Token token_definition;
 };
 
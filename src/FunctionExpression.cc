@@ -108,6 +108,7 @@ std::optional<Expression> FunctionExpression::evaluated(const EvaluationContext&
         }
     }
 
+    context.result.add_used_symbol(name);
     if (const auto function = context.environment->get_function(name)) {
         return function->call(location, new_arguments);
     }
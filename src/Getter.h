@@ -32,6 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef GETTER_H
 #define GETTER_H
 
+#include <mutex>
 #include <string>
 
 #include "Exception.h"
@@ -53,6 +54,8 @@ public:
             throw Exception("cannot find %s", base_filename.c_str());
         }
 
+        // Parsing may get other instances from this getter.
+        auto lock = std::lock_guard(mutex);
         auto it = instances.find(filename);
         if (it != instances.end()) {
             return it->second;
@@ -74,6 +77,7 @@ protected:
 
 private:
     std::unordered_map<Symbol, T> instances;
+    std::recursive_mutex mutex;
 };
 
 #endif // GETTER_H
@@ -34,7 +34,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Exception.h"
 
-void HexStreamEncoder::encode(const std::string& string) {
+void HexStreamEncoder::encode(std::string_view string) {
     for (const auto character : string) {
         encode(character);
     }
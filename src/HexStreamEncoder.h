@@ -34,6 +34,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cstdint>
 #include <ostream>
+#include <string_view>
 
 /// @brief A helper class to encode data a hexadecimal string.
 class HexStreamEncoder {
@@ -59,7 +60,7 @@ public:
      * 
      * @param string The string to encode.
      */
-    void encode(const std::string& string);
+    void encode(std::string_view string);
 
 private:
     /**
@@ -31,13 +31,20 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "IfBody.h"
 
+#include <algorithm>
+
 IfBody::IfBody(std::vector<IfBodyClause> clauses_): clauses(std::move(clauses_)) {
     if (!clauses.empty()) {
         size_range_ = SizeRange(std::numeric_limits<uint64_t>::max(), 0);
         for (const auto& clause: clauses) {
             if (!clause.body.is_error()) {
                 size_range_.minimum = std::min(size_range_.minimum, clause.body.size_range().minimum);
-                size_range_.maximum = std::max(size_range_.maximum, clause.body.size_range().maximum);
+                if (size_range_.maximum && clause.body.size_range().maximum) {
+                    size_range_.maximum = std::max(*size_range_.maximum, *clause.body.size_range().maximum);
+                }
+                else {
+                    size_range_.maximum = {};
+                }
             }
         }
     }
@@ -109,6 +116,10 @@ void IfBody::collect_objects(std::unordered_set<Object*> &objects) const {
     }
 }
 
+bool IfBody::depends_on_position() const {
+    return std::ranges::any_of(clauses, [](const IfBodyClause& clause) {return clause.body.depends_on_position();});
+}
+
 Body IfBody::create(const std::vector<IfBodyClause> &clauses) {
     auto filtered_clauses = std::vector<IfBodyClause>();
 
@@ -56,8 +56,9 @@ public:
 
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<IfBody>(clauses);} // TODO: this doesn't copy clauses
     void collect_objects(std::unordered_set<Object*> &objects) const override;
+    [[nodiscard]] bool depends_on_position() const override;
     [[nodiscard]] bool empty() const override {return clauses.empty();}
-    void encode(std::string &bytes, const Memory* memory) const override {throw Exception("unresolved if");}
+    void encode(ByteSink& bytes, const Memory* memory) const override {throw Exception("unresolved if");}
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override;
 
     void serialize(std::ostream &stream, const std::string& prefix) const override;
@@ -46,7 +46,7 @@ Body InstructionEncoder::encode(const Token& name, const std::vector<std::shared
         throw ParseException(name, "unknown instruction '%s'", name.as_string().c_str());
     }
 
-    auto matches = cpu->match_addressing_modes(arguments);
+    const auto& matches = cpu->match_addressing_modes(arguments);
     if (matches.empty()) {
         throw ParseException(name, "addressing mode not recognized");
     }
@@ -58,7 +58,8 @@ Body InstructionEncoder::encode(const Token& name, const std::vector<std::shared
     for (const auto &match: matches) {
         if (instruction->has_addressing_mode(match.addressing_mode)) {
             supported = true;
-            auto variant = encode(instruction, match, arguments, environment, offset);
+            auto constant_variant = encode_constant(instruction, match, arguments);
+            auto variant = constant_variant ? std::move(*constant_variant) : encode(instruction, match, arguments, environment, offset);
             auto constraint =  variant.argument_constraints.value() && variant.encoding_constraints.value();
 
             if (constraint.has_value() && !*constraint) {
@@ -119,73 +120,15 @@ InstructionEncoder::Variant InstructionEncoder::encode(const Instruction* instru
 
     const auto addressing_mode = cpu->addressing_mode(match.addressing_mode);
     const auto& notation = addressing_mode->notations[match.notation_index];
-    auto it_notation = notation.elements.begin();
-    auto it_arguments = arguments.begin();
 
     Variant variant;
 
-    while (it_notation != notation.elements.end()) {
-        if (it_notation->is_argument()) {
-            auto argument = addressing_mode->argument(it_notation->symbol);
-            auto argument_type = argument->type;
-            switch (argument_type->type()) {
-                case ArgumentType::ANY:
-                case ArgumentType::ENCODING: {
-                    if ((*it_arguments)->type() != Node::EXPRESSION) {
-                        throw ParseException((*it_arguments)->get_location(), "any argument is not an expression");
-                    }
-                    auto expression = std::dynamic_pointer_cast<ExpressionNode>(*it_arguments)->expression;
-
-                    environment->add(it_notation->symbol, expression);
-                    break;
-                }
-
-                case ArgumentType::ENUM: {
-                    if ((*it_arguments)->type() != Node::KEYWORD) {
-                        throw ParseException((*it_arguments)->get_location(), "enum argument is not a keyword");
-                    }
-                    auto enum_type = dynamic_cast<const ArgumentTypeEnum *>(argument_type);
-                    auto value_name = std::dynamic_pointer_cast<TokenNode>(*it_arguments)->as_symbol();
-                    if (!enum_type->has_entry(value_name)) {
-                        throw ParseException((*it_arguments)->get_location(), "invalid enum argument");
-                    }
-                    environment->add(it_notation->symbol, Expression({}, enum_type->entry(value_name)));
-                    break;
-                }
-
-                case ArgumentType::MAP: {
-                    if ((*it_arguments)->type() != Node::EXPRESSION) {
-                        throw ParseException((*it_arguments)->get_location(), "map argument is not an expression");
-                    }
-                    auto expression = std::dynamic_pointer_cast<ExpressionNode>(*it_arguments)->expression;
-                    if (!expression.has_value()) {
-                        throw ParseException((*it_arguments)->get_location(), "map argument is not an integer");
-                    }
-                    auto map_type = dynamic_cast<const ArgumentTypeMap*>(argument_type);
-                    auto value = expression.value().value();
-                    if (!map_type->has_entry(value)) {
-                        throw ParseException((*it_arguments)->get_location(), "invalid map argument");
-                    }
-                    environment->add(it_notation->symbol, Expression({}, map_type->entry(value)));
-                    break;
-                }
-
-                case ArgumentType::RANGE:
-                    auto range_type = dynamic_cast<const ArgumentTypeRange*>(argument_type);
-
-                    if ((*it_arguments)->type() != Node::EXPRESSION) {
-                        throw ParseException((*it_arguments)->get_location(), "range argument is not an expression");
-                    }
-                    auto expression = std::dynamic_pointer_cast<ExpressionNode>(*it_arguments)->expression;
-
-                    variant.add_argument_constraint(InRangeExpression::create(expression.location(), Expression({}, range_type->lower_bound), Expression({}, range_type->upper_bound), expression));
-                    environment->add(it_notation->symbol, expression);
-                    break;
-            }
+    for (const auto& argument: notation.arguments) {
+        auto expression = bind_argument(argument, *arguments[argument.position]);
+        if (argument.range_type) {
+            variant.add_argument_constraint(InRangeExpression::create(expression.location(), Expression({}, argument.range_type->lower_bound), Expression({}, argument.range_type->upper_bound), expression));
         }
-
-        ++it_notation;
-        ++it_arguments;
+        environment->add(argument.name, expression);
     }
 
     for (auto& pair: addressing_mode->arguments) {
@@ -219,6 +162,98 @@ InstructionEncoder::Variant InstructionEncoder::encode(const Instruction* instru
     return variant;
 }
 
+std::optional<InstructionEncoder::Variant> InstructionEncoder::encode_constant(const Instruction* instruction, const AddressingModeMatcherResult& match, const std::vector<std::shared_ptr<Node>>& arguments) const {
+    const auto addressing_mode = cpu->addressing_mode(match.addressing_mode);
+    if (!addressing_mode->encoding_template) {
+        return {};
+    }
+    const auto& encoding_template = *addressing_mode->encoding_template;
+
+    const auto& notation = addressing_mode->notations[match.notation_index];
+
+    auto values = std::vector<std::optional<Value>>(encoding_template.argument_count());
+    Variant variant;
+
+    // Non-constant arguments are left to encode().
+    for (const auto& argument: notation.arguments) {
+        if (!argument.template_index) {
+            return {};
+        }
+        auto value = bind_argument(argument, *arguments[argument.position]).value();
+        if (!value) {
+            return {};
+        }
+        if (argument.range_type && !(argument.range_type->lower_bound <= *value && argument.range_type->upper_bound >= *value)) {
+            variant.argument_constraints = Expression({}, false);
+        }
+        values[*argument.template_index] = std::move(value);
+    }
+
+    for (size_t index = 0; index < values.size(); index++) {
+        if (!values[index]) {
+            const auto& default_value = addressing_mode->argument(encoding_template.argument_name(index))->default_value;
+            if (!default_value) {
+                return {};
+            }
+            values[index] = default_value;
+        }
+    }
+
+    variant.uses_pc = addressing_mode->uses_pc;
+    if (auto data = encoding_template.encode(values, Value(instruction->opcode(match.addressing_mode)))) {
+        variant.data = Body(std::move(*data));
+    }
+    else {
+        variant.encoding_constraints = Expression({}, false);
+    }
+
+    return variant;
+}
+
+Expression InstructionEncoder::bind_argument(const AddressingMode::Notation::ResolvedArgument& argument, const Node& node) {
+    switch (argument.type) {
+        case ArgumentType::ANY:
+        case ArgumentType::ENCODING:
+            if (node.type() != Node::EXPRESSION) {
+                throw ParseException(node.get_location(), "any argument is not an expression");
+            }
+            return static_cast<const ExpressionNode&>(node).expression;
+
+        case ArgumentType::ENUM: {
+            if (node.type() != Node::KEYWORD) {
+                throw ParseException(node.get_location(), "enum argument is not a keyword");
+            }
+            auto value_name = static_cast<const TokenNode&>(node).as_symbol();
+            if (!argument.enum_type->has_entry(value_name)) {
+                throw ParseException(node.get_location(), "invalid enum argument");
+            }
+            return Expression({}, argument.enum_type->entry(value_name));
+        }
+
+        case ArgumentType::MAP: {
+            if (node.type() != Node::EXPRESSION) {
+                throw ParseException(node.get_location(), "map argument is not an expression");
+            }
+            auto value = static_cast<const ExpressionNode&>(node).expression.value();
+            if (!value) {
+                throw ParseException(node.get_location(), "map argument is not an integer");
+            }
+            if (!argument.map_type->has_entry(*value)) {
+                throw ParseException(node.get_location(), "invalid map argument");
+            }
+            return Expression({}, argument.map_type->entry(*value));
+        }
+
+        case ArgumentType::RANGE:
+            if (node.type() != Node::EXPRESSION) {
+                throw ParseException(node.get_location(), "range argument is not an expression");
+            }
+            return static_cast<const ExpressionNode&>(node).expression;
+    }
+
+    throw Exception("internal error: unknown argument type");
+}
+
 void InstructionEncoder::Variant::add_constraint(Expression& constraints, const Expression& sub_constraint) {
     constraints = Expression({constraints.location(), sub_constraint.location()}, constraints, Expression::BinaryOperation::LOGICAL_AND, sub_constraint);
 }
@@ -64,6 +64,10 @@ private:
         static void add_constraint(Expression& constraint, const Expression& sub_constraint);
     };
 
+    // Encode variant with constant arguments using the addressing mode's encoding template, without evaluating its encoding. Returns no value if that's not possible.
+    [[nodiscard]] std::optional<Variant> encode_constant(const Instruction* instruction, const AddressingModeMatcherResult& match, const std::vector<std::shared_ptr<Node>>& arguments) const;
+    // Get the value bound to an addressing mode argument, reporting invalid arguments.
+    [[nodiscard]] static Expression bind_argument(const AddressingMode::Notation::ResolvedArgument& argument, const Node& node);
     Variant encode(const Instruction* instruction, const AddressingModeMatcherResult& match, const std::vector<std::shared_ptr<Node>>& arguments, std::shared_ptr<Environment> outer_environment, const SizeRange& offset) const;
 
     const CPU* cpu;
@@ -82,9 +82,9 @@ size_t Int::minimum_byte_size(int64_t value) {
     }
 }
 
-void Int::encode(std::string &bytes, uint64_t value, uint64_t size, uint64_t byte_order) {
+void Int::encode(ByteSink& bytes, uint64_t value, uint64_t size, uint64_t byte_order) {
     if (size == 1) {
-        bytes += static_cast<char>(value & 0xff);
+        bytes.append(static_cast<char>(value & 0xff));
     }
     else {
         uint64_t mask = 10000000;
@@ -100,7 +100,7 @@ void Int::encode(std::string &bytes, uint64_t value, uint64_t size, uint64_t byt
                 continue;
             }
             uint64_t byte = (value >> (byte_index * 8)) & 0xff;
-            bytes += static_cast<char>(byte);
+            bytes.append(static_cast<char>(byte));
         }
     }
 }
@@ -50,7 +50,7 @@ std::ostream& operator<<(std::ostream& stream, const IntegerEncoder& encoding) {
 
 bool IntegerEncoder::operator==(const IntegerEncoder& other) const { return type == other.type && size == other.size && explicit_byte_order == other.explicit_byte_order; }
 
-void IntegerEncoder::encode(std::string& bytes, const Value& value) const {
+void IntegerEncoder::encode(ByteSink& bytes, const Value& value) const {
     if (!fits(value)) {
         throw Exception("value overflow");
     }
@@ -47,7 +47,7 @@ public:
     explicit IntegerEncoder(const Value& value);
 
     [[nodiscard]] std::optional<size_t> byte_size() const {return size;}
-    void encode(std::string& bytes, const Value& value) const override;
+    void encode(ByteSink& bytes, const Value& value) const override;
     [[nodiscard]] size_t encoded_size(const Value& value) const override;
     [[nodiscard]] bool fits(const Value& value) const override;
     [[nodiscard]] bool is_natural_encoder(const Value& value) const override;
@@ -41,7 +41,8 @@ public:
     explicit LabelBody(Symbol name): name(name) {}
     LabelBody(Symbol name, const SizeRange& offset, bool added_to_environment, size_t unnamed_index): name(name), offset(offset), unnamed_index(unnamed_index), added_to_environment(added_to_environment) {}
 
-    void encode(std::string &bytes, const Memory* memory) const override {}
+    [[nodiscard]] bool depends_on_position() const override {return true;}
+    void encode(ByteSink& bytes, const Memory* memory) const override {}
     [[nodiscard]] bool empty() const override {return added_to_environment && offset.size();}
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {throw Exception("can't clone label");}
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override;
@@ -139,6 +139,9 @@ std::optional<Expression> LabelExpression::evaluated(const EvaluationContext& co
         }
     }
 
+    if (!object_name.empty()) {
+        context.result.add_used_symbol(object_name);
+    }
     if (new_object) {
         // TODO: handle scope
         if (auto found_offset = new_object->environment->get_label(label_name)) {
@@ -151,7 +154,7 @@ std::optional<Expression> LabelExpression::evaluated(const EvaluationContext& co
         }
     }
 
-    if (new_object != object || new_label_name != label_name || new_offset != offset || (new_offset.has_size() && context.label_offset.has_size())) {
+    if (new_object != object || new_label_name != label_name || new_offset != offset || (new_offset.has_size() && context.label_offset.has_size() && !context.keep_label_offsets)) {
         return Expression(location, new_object, new_label_name, new_offset, context.label_offset, context.keep_label_offsets);
     }
 
@@ -31,4 +31,17 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "LibraryGetter.h"
 
+#include "BinaryObjectFile.h"
+
 LibraryGetter LibraryGetter::global;
+
+std::shared_ptr<ObjectFile> LibraryGetter::parse(Symbol name, Symbol filename) {
+    auto file = std::make_shared<const MappedFile>(filename);
+
+    if (BinaryObjectFile::is_binary(*file)) {
+        return BinaryObjectFile::read(filename, std::move(file));
+    }
+    else {
+        return ObjectFileParser().parse(filename);
+    }
+}
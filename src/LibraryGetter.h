@@ -42,7 +42,7 @@ public:
 
 protected:
     std::string filename_extension() const override {return ".lib";}
-    std::shared_ptr<ObjectFile> parse(Symbol name, Symbol filename) override {return ObjectFileParser().parse(filename);}
+    std::shared_ptr<ObjectFile> parse(Symbol name, Symbol filename) override;
 };
 
 #endif // LIBRARY_GETTER_H
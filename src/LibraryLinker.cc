@@ -31,14 +31,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "LibraryLinker.h"
 
+#include "BinaryObjectFile.h"
 #include "Exception.h"
 #include <fstream>
 
 void LibraryLinker::link_sub() {
     Target::set_current_target(target);
     program->evaluate();
-    program->evaluate(); // TODO: shouldn't be necessary
-    program->evaluate(); // TODO: shouldn't be necessary
     Unresolved unresolved;
     if (!program->check_unresolved(unresolved)) {
         unresolved.report();
@@ -49,6 +48,12 @@ void LibraryLinker::link_sub() {
 
 void LibraryLinker::output(const std::string& file_name) {
     // TODO: only output used entities
-    auto stream = std::ofstream(file_name);
-    stream << *(program);
+    if (binary) {
+        auto stream = std::ofstream(file_name, std::ios::binary);
+        BinaryObjectFile::write(stream, *program, Symbol(file_name));
+    }
+    else {
+        auto stream = std::ofstream(file_name);
+        stream << *(program);
+    }
 }
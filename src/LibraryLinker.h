@@ -38,6 +38,8 @@ class LibraryLinker: public Linker {
   public:
     void output(const std::string& file_name) override;
 
+    bool binary{false};
+
   protected:
     void link_sub() override;
     UsedEntities roots() override {return program->public_entities();}
@@ -0,0 +1,193 @@
+/*
+LinkCache.cc -- addresses and encoded bytes of objects from previous link
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "LinkCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "ContentHash.h"
+#include "Exception.h"
+#include "HexStreamEncoder.h"
+#include "HexStringDecoder.h"
+#include "Object.h"
+
+#define HEADER "xlr8-link-cache 2"
+
+LinkCache::LinkCache(std::string file_name_, Symbol target, uint64_t definitions_hash): file_name(std::move(file_name_)), target(target), definitions_hash(definitions_hash) {
+    auto stream = std::ifstream(file_name);
+    auto line = std::string();
+    auto header = std::ostringstream();
+    header << HEADER " " << target << " " << std::hex << definitions_hash;
+    if (!std::getline(stream, line) || line != header.str()) {
+        return;
+    }
+
+    try {
+        while (std::getline(stream, line)) {
+            auto fields = std::istringstream(line);
+            uint64_t bank, address;
+            auto digest = std::string();
+            auto bytes = std::string();
+            fields >> std::hex >> bank >> address >> digest >> bytes;
+            fields.ignore(1);
+            auto object_key = std::string();
+            if (!fields || !std::getline(fields, object_key)) {
+                throw Exception();
+            }
+            auto entry = Entry{Address(bank, address), {}, {}};
+            if (digest != "-") {
+                entry.digest = std::stoull(digest, nullptr, 16);
+                if (bytes != "-") {
+                    auto decoder = HexStringDecoder();
+                    decoder.decode(bytes);
+                    entry.bytes = decoder.end();
+                }
+            }
+            previous_entries.insert_or_assign(object_key, std::move(entry));
+        }
+    }
+    catch (...) {
+        previous_entries.clear();
+    }
+}
+
+std::optional<Address> LinkCache::address(const Object* object) const {
+    const auto it = previous_entries.find(key(object));
+    if (it == previous_entries.end()) {
+        return {};
+    }
+    const auto& address = it->second.address;
+    if (object->alignment > 0 && address.address % object->alignment != 0) {
+        return {};
+    }
+    auto range = Range(address.address, *object->size_range().size());
+    for (const auto& block: object->section->blocks) {
+        if (block.bank == address.bank && block.range.contains(range)) {
+            return address;
+        }
+    }
+    return {};
+}
+
+uint64_t LinkCache::digest(const Object* object) {
+    auto hash = ContentHash();
+    hash.add(serialization_hash(object));
+    hash.add(object->address->bank);
+    hash.add(object->address->address);
+
+    auto referenced_objects = std::vector<const Object*>(object->referenced_objects.begin(), object->referenced_objects.end());
+    std::ranges::sort(referenced_objects, Object::less_pointers);
+    for (auto referenced_object: referenced_objects) {
+        hash.add(serialization_hash(referenced_object));
+        if (referenced_object->address) {
+            hash.add(referenced_object->address->bank);
+            hash.add(referenced_object->address->address);
+        }
+    }
+
+    return hash.value();
+}
+
+std::optional<std::string_view> LinkCache::bytes(const Object* object, uint64_t digest) const {
+    const auto object_key = key(object);
+    if (ambiguous_keys.contains(object_key)) {
+        return {};
+    }
+    const auto it = previous_entries.find(object_key);
+    if (it == previous_entries.end() || it->second.digest != digest || it->second.bytes.size() != *object->size_range().size()) {
+        return {};
+    }
+    return it->second.bytes;
+}
+
+void LinkCache::add(const Object* object) {
+    auto object_key = key(object);
+    if (!entries.emplace(object_key, Entry{*object->address, {}, {}}).second) {
+        ambiguous_keys.insert(object_key);
+    }
+}
+
+void LinkCache::add_bytes(const Object* object, uint64_t digest, std::string_view bytes) {
+    auto it = entries.find(key(object));
+    if (it != entries.end()) {
+        it->second.digest = digest;
+        it->second.bytes = bytes;
+    }
+}
+
+void LinkCache::write() const {
+    auto stream = std::ofstream(file_name);
+    stream << HEADER " " << target << " " << std::hex << definitions_hash << std::dec << "\n";
+    for (const auto& [object_key, entry]: entries) {
+        if (ambiguous_keys.contains(object_key)) {
+            continue;
+        }
+        stream << std::hex << entry.address.bank << " " << entry.address.address << " ";
+        if (entry.digest) {
+            stream << *entry.digest << " ";
+            if (entry.bytes.empty()) {
+                stream << "-";
+            }
+            else {
+                HexStreamEncoder(stream).encode(entry.bytes);
+            }
+        }
+        else {
+            stream << "- -";
+        }
+        stream << std::dec << " " << object_key << "\n";
+    }
+    stream.close();
+    if (stream.fail()) {
+        throw Exception("can't write link cache '%s'", file_name.c_str());
+    }
+}
+
+std::string LinkCache::key(const Object* object) {
+    auto stream = std::ostringstream();
+    stream << object->name << " " << object->section->name << " " << *object->size_range().size() << " " << object->alignment;
+    return stream.str();
+}
+
+uint64_t LinkCache::serialization_hash(const Object* object) {
+    auto it = serialization_hashes.find(object);
+    if (it == serialization_hashes.end()) {
+        auto stream = std::ostringstream();
+        object->serialize(stream);
+        auto hash = ContentHash();
+        hash.add(stream.str());
+        it = serialization_hashes.emplace(object, hash.value()).first;
+    }
+    return it->second;
+}
@@ -0,0 +1,142 @@
+#ifndef LINK_CACHE_H
+#define LINK_CACHE_H
+
+/*
+LinkCache.h -- addresses and encoded bytes of objects from previous link
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Address.h"
+#include "Symbol.h"
+
+class Object;
+
+/**
+ * Addresses and encoded bytes of objects from a previous link, so relinking can keep objects that haven't changed in
+ * place and skip evaluating and encoding them.
+ *
+ * Objects are identified by name, section, size, and alignment, which are all that determine where they can be placed.
+ * Whether an object's bytes can be reused is decided by its digest, see `digest()`. The whole cache is discarded if
+ * the target or any file read while parsing it changed.
+ *
+ * Since objects keep their address, the result of a link depends on the previous links.
+ */
+class LinkCache {
+  public:
+    /**
+     * Create a link cache, loading the previous link's results if the file exists.
+     *
+     * A missing, unreadable, or outdated file results in an empty cache.
+     *
+     * @param file_name The file the cache is stored in.
+     * @param target The name of the target linked for.
+     * @param definitions_hash Hash of the contents of the files defining the target.
+     */
+    LinkCache(std::string file_name, Symbol target, uint64_t definitions_hash);
+
+    /**
+     * Get the address an object had in the previous link.
+     *
+     * @param object The object to look up.
+     * @return The address, or std::nullopt if the object changed or it no longer fits its section at that address.
+     */
+    [[nodiscard]] std::optional<Address> address(const Object* object) const;
+
+    /**
+     * Compute the digest of a placed object, which determines its encoded bytes.
+     *
+     * After the program has been evaluated, an object's body refers to other objects only by address and label. The
+     * digest covers the object's serialization and address, and the addresses and serializations of the objects it
+     * references.
+     *
+     * @param object The placed object.
+     * @return The digest of the object.
+     */
+    [[nodiscard]] uint64_t digest(const Object* object);
+
+    /**
+     * Get the bytes an object was encoded to in the previous link.
+     *
+     * @param object The placed object.
+     * @param digest The digest of the object.
+     * @return The encoded bytes, or std::nullopt if the object or anything it depends on changed.
+     */
+    [[nodiscard]] std::optional<std::string_view> bytes(const Object* object, uint64_t digest) const;
+
+    /**
+     * Record the address of an object, to be written to the cache.
+     *
+     * @param object The placed object.
+     */
+    void add(const Object* object);
+
+    /**
+     * Record the encoded bytes of an object, to be written to the cache.
+     *
+     * @param object The placed object, which must have been added.
+     * @param digest The digest of the object.
+     * @param bytes The bytes the object was encoded to.
+     */
+    void add_bytes(const Object* object, uint64_t digest, std::string_view bytes);
+
+    /**
+     * Write the recorded addresses and bytes to the cache file.
+     *
+     * @throws Exception if the file can't be written.
+     */
+    void write() const;
+
+  private:
+    class Entry {
+    public:
+        Address address;
+        std::optional<uint64_t> digest;
+        std::string bytes;
+    };
+
+    [[nodiscard]] static std::string key(const Object* object);
+    [[nodiscard]] uint64_t serialization_hash(const Object* object);
+
+    std::string file_name;
+    Symbol target;
+    uint64_t definitions_hash;
+    std::unordered_map<std::string, Entry> previous_entries;
+    std::map<std::string, Entry> entries;
+    std::unordered_set<std::string> ambiguous_keys; // Objects sharing a key can't be told apart.
+    std::unordered_map<const Object*, uint64_t> serialization_hashes;
+};
+
+#endif // LINK_CACHE_H
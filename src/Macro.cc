@@ -31,14 +31,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Macro.h"
 
-bool Macro::initialized = false;
+std::once_flag Macro::initialized;
 Token Macro::token_body;
 
 void Macro::initialize() {
-    if (!initialized) {
-        initialized = true;
+    std::call_once(initialized, [] {
         token_body = Token(Token::NAME, "body");
-    }
+    });
 }
 
 
@@ -62,11 +61,35 @@ std::ostream& operator<<(std::ostream& stream, const Macro& macro) {
 
 
 Body Macro::expand(const std::vector<Expression>& arguments, std::shared_ptr<Environment> outer_environment) const {
+    auto inner_environment = std::make_shared<Environment>(environment, std::move(outer_environment));
+    return bound_body(arguments).scoped(inner_environment);
+}
+
+
+Body Macro::bound_body(const std::vector<Expression>& arguments) const {
+    auto key = constant_arguments(arguments);
+    if (key) {
+        auto it = expansions.find(*key);
+        if (it != expansions.end()) {
+            return it->second;
+        }
+    }
+
     EvaluationResult result;
-    auto inner_environment = std::make_shared<Environment>(*environment);
-    inner_environment->clear_next();
-    inner_environment->add_next(std::move(outer_environment));
-    return body.evaluated(EvaluationContext(result, EvaluationContext::MACRO_EXPANSION, bind(arguments))).value_or(body).scoped(inner_environment);
+    auto new_body = body.evaluated(EvaluationContext(result, EvaluationContext::MACRO_EXPANSION, bind(arguments))).value_or(body);
+    if (key) {
+        expansions.emplace(std::move(*key), new_body);
+    }
+    return new_body;
+}
+
+
+bool Macro::evaluate_inner(EvaluationContext& context) {
+    if (!body.evaluate(context)) {
+        return false;
+    }
+    expansions.clear();
+    return true;
 }
 
 
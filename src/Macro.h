@@ -32,6 +32,9 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef MACRO_H
 #define MACRO_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include "Body.h"
 #include "Callable.h"
 
@@ -47,12 +50,18 @@ class Macro: public Callable {
 
   protected:
     [[nodiscard]] EvaluationContext evaluation_context(EvaluationResult& result) override;
-    void evaluate_inner(EvaluationContext &context) override {body.evaluate(context);}
+    bool evaluate_inner(EvaluationContext &context) override;
 
   private:
+    [[nodiscard]] Body bound_body(const std::vector<Expression>& arguments) const;
+
     static void initialize();
 
-    static bool initialized;
+    // Body with arguments bound, by constant argument values. Cleared when body changes.
+    // Not locked: a macro is only expanded by the thread assembling its file, or while linking, which is sequential.
+    mutable std::unordered_map<std::vector<Value>, Body, ArgumentsHash, ArgumentsEqual> expansions;
+
+    static std::once_flag initialized;
     static Token token_body;
 };
 
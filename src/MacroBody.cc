@@ -49,6 +49,7 @@ std::optional<Body> MacroBody::evaluated(const EvaluationContext& context) const
     }
 
     if (context.entity || context.type == EvaluationContext::OUTPUT) {
+        context.result.add_used_symbol(name.as_symbol());
         if (!new_macro) {
             if (auto found_macro = context.environment->get_macro(name.as_symbol())) {
                 new_macro = found_macro;
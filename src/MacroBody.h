@@ -41,8 +41,9 @@ class MacroBody: public BodyElement {
     MacroBody(const Token& name, std::vector<Expression> arguments, const Macro* macro = {}): BodyElement(SizeRange(0,{})), name(name), macro(macro), arguments(std::move(arguments)) {}
 
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {throw Exception("can't clone MacroBody");}
+    [[nodiscard]] bool depends_on_position() const override {return true;} // The expansion may define labels.
     [[nodiscard]] bool empty() const override {return false;}
-    void encode(std::string &bytes, const Memory *memory) const override {throw ParseException(name, "can't encode unexpanded macro call");}
+    void encode(ByteSink& bytes, const Memory *memory) const override {throw ParseException(name, "can't encode unexpanded macro call");}
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext &context) const override;
     void serialize(std::ostream &stream, const std::string &prefix) const override;
 
@@ -0,0 +1,75 @@
+/*
+MappedFile.cc -- read-only memory mapped file
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Exception.h"
+
+MappedFile::MappedFile(Symbol file_name) {
+    auto fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw Exception("can't open '%s': %s", file_name.c_str(), strerror(errno));
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0) {
+        auto error = errno;
+        close(fd);
+        throw Exception("can't stat '%s': %s", file_name.c_str(), strerror(error));
+    }
+
+    if (st.st_size > 0) {
+        auto mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            auto error = errno;
+            close(fd);
+            throw Exception("can't map '%s': %s", file_name.c_str(), strerror(error));
+        }
+        address = static_cast<const char*>(mapping);
+        length = static_cast<size_t>(st.st_size);
+    }
+
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (address) {
+        munmap(const_cast<char*>(address), length);
+    }
+}
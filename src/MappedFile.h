@@ -0,0 +1,56 @@
+/*
+MappedFile.h -- read-only memory mapped file
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string_view>
+
+#include "Symbol.h"
+
+class MappedFile {
+public:
+    explicit MappedFile(Symbol file_name);
+    MappedFile(const MappedFile& other) = delete;
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    [[nodiscard]] const char* data() const {return address;}
+    [[nodiscard]] size_t size() const {return length;}
+    [[nodiscard]] std::string_view contents() const {return {address, length};}
+
+private:
+    const char* address{};
+    size_t length{0};
+};
+
+#endif // MAPPED_FILE_H
@@ -31,79 +31,223 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Memory.h"
 
+#include <bit>
 #include <iomanip>
 #include <ostream>
+#include <ranges>
 #include <sstream>
 
 #include "Exception.h"
 #include <iostream>
 
-Memory::Bank::Bank(Range range, uint8_t fill_byte) : range(range) {
-    memory = std::string(range.size, static_cast<char>(fill_byte));
-    blocks.emplace_back(FREE, range);
+Memory::Bank::Bank(Range range, uint8_t fill_byte) : range(range), fill_byte(fill_byte) {
+    free_blocks.resize(64);
+    insert_block(FREE, range);
 }
 
-void Memory::Bank::copy(uint64_t address, const std::string& data) {
-    auto target_range = Range(address, data.size());
-    if (!range.contains(target_range)) {
+std::span<char> Memory::Bank::region(const Range& requested_range) {
+    if (!range.contains(requested_range)) {
         auto str = std::stringstream{};
-        str << "data " << target_range << " out of range " << range;
+        str << "data " << requested_range << " out of range " << range;
         throw Exception(str.str());
     }
-    memory.replace(offset(address), data.size(), data);
+    if (memory.empty()) {
+        memory = std::string(range.size, static_cast<char>(fill_byte));
+    }
+    return std::span<char>(memory).subspan(offset(requested_range.start), requested_range.size);
 }
 
-std::optional<uint64_t> Memory::Bank::allocate(const Range& allowed_range, Memory::Allocation allocation, uint64_t alignment, uint64_t size) {
+std::optional<uint64_t> Memory::Bank::allocate(const Range& allowed_range, Memory::Allocation allocation, uint64_t alignment, uint64_t size, Fit fit) {
     if (allowed_range.size < size) {
         return {};
     }
 
-    for (auto it = blocks.begin(); it != blocks.end(); ++it) {
-        if (it->allocation != FREE) {
-            continue;
+    auto it = find_free_block(allowed_range, alignment, size, fit);
+    if (it == blocks.end()) {
+        return {};
+    }
+
+    auto available_range = it->second.range.intersect(allowed_range);
+    available_range.align(alignment);
+    if (size == 0) {
+        return available_range.start;
+    }
+
+    auto free_range = it->second.range;
+    erase_block(it);
+    if (available_range.start > free_range.start) {
+        insert_block(FREE, {free_range.start, available_range.start - free_range.start});
+    }
+    auto allocated = insert_block(allocation, {available_range.start, size});
+    if (available_range.start + size <= free_range.end()) {
+        insert_block(FREE, {available_range.start + size, free_range.end() - (available_range.start + size) + 1});
+    }
+    merge_neighbors(allocated);
+
+    return available_range.start;
+}
+
+std::optional<Range> Memory::Bank::find_free_space(const Range& allowed_range, uint64_t alignment, uint64_t size, Fit fit) const {
+    if (allowed_range.size < size) {
+        return {};
+    }
+
+    auto it = find_free_block(allowed_range, alignment, size, fit);
+    if (it == blocks.end()) {
+        return {};
+    }
+    return it->second.range.intersect(allowed_range);
+}
+
+uint64_t Memory::Bank::free_size(const Range& requested_range) const {
+    uint64_t size = 0;
+
+    auto it = blocks.upper_bound(requested_range.start);
+    if (it != blocks.begin()) {
+        it = std::prev(it);
+    }
+    for (; it != blocks.end() && it->first <= requested_range.end(); ++it) {
+        if (it->second.allocation == FREE) {
+            size += it->second.range.intersect(requested_range).size;
         }
-        auto available_range = it->range.intersect(allowed_range);
-        available_range.align(alignment);
+    }
+
+    return size;
+}
+
+uint64_t Memory::Bank::fragmented_size(const Range& requested_range) const {
+    uint64_t size = 0;
 
-        if (available_range.size < size) {
+    for (auto it = blocks.lower_bound(requested_range.start); it != blocks.end() && it->first <= requested_range.end(); ++it) {
+        if (it->second.allocation != FREE || it == blocks.begin()) {
             continue;
         }
-
-        if (it->range.size == size) {
-            it->allocation = allocation;
+        auto next = std::next(it);
+        // Adjacent free blocks are always merged, so the neighbors of a free block are allocated.
+        if (next != blocks.end() && std::prev(it)->first >= requested_range.start && next->second.range.end() <= requested_range.end()) {
+            size += it->second.range.size;
         }
-        else if (it->range.start == available_range.start) {
-            it->range.remove_left(size);
-            it = blocks.insert(it, Block(allocation, {available_range.start, size}));
+    }
+
+    return size;
+}
+
+Memory::Bank::BlockMap::const_iterator Memory::Bank::find_free_block(const Range& allowed_range, uint64_t alignment, uint64_t size, Fit fit) const {
+    auto fits = [&allowed_range, alignment, size](const Block& block) {
+        auto available_range = block.range.intersect(allowed_range);
+        available_range.align(alignment);
+        return !available_range.empty() && available_range.size >= size;
+    };
+
+    if (fit == BEST_FIT) {
+        auto best = blocks.end();
+        uint64_t best_size = 0;
+        auto consider = [&](BlockMap::const_iterator block) {
+            if (block->second.allocation != FREE || !fits(block->second)) {
+                return;
+            }
+            auto available_size = block->second.range.intersect(allowed_range).size;
+            if (best == blocks.end() || available_size < best_size || (available_size == best_size && block->first < best->first)) {
+                best = block;
+                best_size = available_size;
+            }
+        };
+
+        // Only the blocks overlapping the ends of the allowed range can be smaller than their size class.
+        auto it = blocks.upper_bound(allowed_range.start);
+        if (it != blocks.begin()) {
+            consider(std::prev(it));
         }
-        else {
-            auto old_start = it->range.start;
-            it->range.set_start(available_range.start + size);
-            it = blocks.insert(it, Block(allocation, {available_range.start, size}));
-            it = blocks.insert(it, Block(FREE, {old_start, available_range.start - old_start}));
-            it = std::next(it);
+        it = blocks.upper_bound(allowed_range.end());
+        if (it != blocks.begin()) {
+            consider(std::prev(it));
         }
 
-        if (it != blocks.begin()) {
-            auto previous = std::prev(it);
-            if (previous->allocation == it->allocation && previous->range.end() + 1 == it->range.start) {
-                previous->range.set_end(it->range.end());
-                blocks.erase(it);
-                it = previous;
+        for (auto index = size_class(size); index < free_blocks.size(); index++) {
+            if (best != blocks.end() && best_size < uint64_t{1} << index) {
+                break;
+            }
+            const auto& starts = free_blocks[index];
+            for (auto start_it = starts.lower_bound(allowed_range.start); start_it != starts.end() && start_it->first <= allowed_range.end(); ++start_it) {
+                if (start_it->second >= size) {
+                    consider(blocks.find(start_it->first));
+                }
             }
         }
-        if (it != blocks.end()) {
-            auto next = std::next(it);
-            if (next->allocation == it->allocation && next->range.start == it->range.end() + 1) {
-                it->range.set_end(next->range.end());
-                blocks.erase(next);
+
+        return best;
+    }
+
+    // A free block overlapping the start of the allowed range has the lowest possible address.
+    auto it = blocks.upper_bound(allowed_range.start);
+    if (it != blocks.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second.allocation == FREE && fits(previous->second)) {
+            return previous;
+        }
+    }
+
+    // Smaller size classes can't hold the allocation; check the lowest fitting block of each larger one.
+    auto best = blocks.end();
+    for (auto index = size_class(size); index < free_blocks.size(); index++) {
+        const auto& starts = free_blocks[index];
+        for (auto start_it = starts.lower_bound(allowed_range.start); start_it != starts.end() && start_it->first <= allowed_range.end(); ++start_it) {
+            if (best != blocks.end() && start_it->first >= best->first) {
+                break;
+            }
+            if (start_it->second < size) {
+                continue;
+            }
+            auto block = blocks.find(start_it->first);
+            if (fits(block->second)) {
+                best = block;
+                break;
             }
         }
+    }
 
-        return available_range.start;
+    return best;
+}
+
+Memory::Bank::BlockMap::iterator Memory::Bank::insert_block(Allocation allocation, const Range& block_range) {
+    if (allocation == FREE) {
+        free_blocks[size_class(block_range.size)][block_range.start] = block_range.size;
+    }
+    return blocks.insert({block_range.start, Block(allocation, block_range)}).first;
+}
+
+void Memory::Bank::erase_block(BlockMap::const_iterator it) {
+    if (it->second.allocation == FREE) {
+        free_blocks[size_class(it->second.range.size)].erase(it->first);
+    }
+    blocks.erase(it);
+}
+
+void Memory::Bank::merge_neighbors(BlockMap::iterator it) {
+    auto allocation = it->second.allocation;
+    auto merged_range = it->second.range;
+
+    if (it != blocks.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second.allocation == allocation && previous->second.range.end() + 1 == merged_range.start) {
+            merged_range = previous->second.range.add(merged_range);
+            erase_block(previous);
+        }
+    }
+    auto next = std::next(it);
+    if (next != blocks.end() && next->second.allocation == allocation && next->first == merged_range.end() + 1) {
+        merged_range = merged_range.add(next->second.range);
+        erase_block(next);
     }
 
-    return {};
+    if (merged_range != it->second.range) {
+        erase_block(it);
+        insert_block(allocation, merged_range);
+    }
+}
+
+size_t Memory::Bank::size_class(uint64_t size) {
+    return size == 0 ? 0 : static_cast<size_t>(std::bit_width(size)) - 1;
 }
 
 Range Memory::Bank::data_range() const {
@@ -111,7 +255,7 @@ Range Memory::Bank::data_range() const {
     uint64_t start = 0;
     uint64_t end = 0;
 
-    for (const auto& block : blocks) {
+    for (const auto& block : blocks | std::views::values) {
         if (block.allocation == DATA) {
             if (!have_data) {
                 have_data = true;
@@ -133,14 +277,36 @@ std::string Memory::Bank::data(const Range& requested_range) const {
     auto result = std::string(requested_range.size, 0);
     auto overlap_range = requested_range.intersect(range);
     if (!overlap_range.empty()) {
-        result.replace(overlap_range.start - requested_range.start, overlap_range.size, memory, offset(overlap_range.start), overlap_range.size);
+        if (memory.empty()) {
+            result.replace(overlap_range.start - requested_range.start, overlap_range.size, overlap_range.size, static_cast<char>(fill_byte));
+        }
+        else {
+            result.replace(overlap_range.start - requested_range.start, overlap_range.size, memory, offset(overlap_range.start), overlap_range.size);
+        }
     }
     return result;
 }
 
+void Memory::Bank::append_data(ByteSink& bytes, const Range& requested_range) const {
+    auto overlap_range = requested_range.intersect(range);
+    if (overlap_range.empty()) {
+        bytes.append(requested_range.size, '\0');
+        return;
+    }
+
+    bytes.append(overlap_range.start - requested_range.start, '\0');
+    if (memory.empty()) {
+        bytes.append(overlap_range.size, static_cast<char>(fill_byte));
+    }
+    else {
+        bytes.append(std::string_view(memory).substr(offset(overlap_range.start), overlap_range.size));
+    }
+    bytes.append(requested_range.end() - overlap_range.end(), '\0');
+}
+
 void Memory::Bank::debug_blocks(std::ostream& stream) const {
     stream << "allocation blocks:" << std::endl;
-    for (const auto& block : blocks) {
+    for (const auto& block : blocks | std::views::values) {
         stream << std::hex << std::setfill('0') << "  " << std::setw(4) << block.range.start << "-" << std::setw(4) << block.range.end() << ": ";
         switch (block.allocation) {
             case DATA:
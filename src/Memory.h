@@ -32,11 +32,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ACCELERATE_MEMORY_H
 #define ACCELERATE_MEMORY_H
 
-#include <list>
+#include <map>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "ByteSink.h"
 #include "Range.h"
 
 /**
@@ -51,6 +53,12 @@ public:
         RESERVED ///< Reserved block.
     };
 
+    /// @brief How to choose among the free blocks that can hold an allocation.
+    enum Fit {
+        FIRST_FIT, ///< Use the free block with the lowest address.
+        BEST_FIT ///< Use the smallest free block, leaving larger ones for later allocations.
+    };
+
     /**
      * Class representing a bank of memory.
      */
@@ -71,17 +79,46 @@ public:
          * @param allocation The type of allocation.
          * @param alignment The alignment requirement.
          * @param size The size of the block to allocate.
+         * @param fit How to choose the free block to allocate from.
          * @return The starting address of the allocated block, or std::nullopt if allocation failed.
          */
-        std::optional<uint64_t> allocate(const Range& allowed_range, Allocation allocation, uint64_t alignment, uint64_t size);
+        std::optional<uint64_t> allocate(const Range& allowed_range, Allocation allocation, uint64_t alignment, uint64_t size, Fit fit = FIRST_FIT);
+
+        /**
+         * Find the free space an allocation would be taken from, without allocating it.
+         * 
+         * @param allowed_range The range of addresses allowed for allocation.
+         * @param alignment The alignment requirement.
+         * @param size The size of the block to allocate.
+         * @param fit How to choose the free block.
+         * @return The part of the chosen free block within the allowed range, or std::nullopt if none is large enough.
+         */
+        [[nodiscard]] std::optional<Range> find_free_space(const Range& allowed_range, uint64_t alignment, uint64_t size, Fit fit = FIRST_FIT) const;
 
         /**
-         * Copy data into the memory at a specified address.
+         * Get the number of free bytes within a range.
          * 
-         * @param start The starting address to copy the data to.
-         * @param data The data to copy.
+         * @param requested_range The range of addresses to check.
+         * @return The number of free bytes.
          */
-        void copy(uint64_t start, const std::string& data);
+        [[nodiscard]] uint64_t free_size(const Range& requested_range) const;
+
+        /**
+         * Get the number of free bytes within a range that are enclosed by allocated blocks.
+         * 
+         * @param requested_range The range of addresses to check.
+         * @return The number of enclosed free bytes.
+         */
+        [[nodiscard]] uint64_t fragmented_size(const Range& requested_range) const;
+
+        /**
+         * Get writable memory to encode data into in place.
+         *
+         * @param requested_range The range of addresses to write to.
+         * @return The memory covering the range.
+         * @throws Exception if the range is not within the bank.
+         */
+        [[nodiscard]] std::span<char> region(const Range& requested_range);
 
         /**
          * Get the range of addresses containing data.
@@ -98,6 +135,14 @@ public:
          */
         [[nodiscard]] std::string data(const Range& requested_range) const;
 
+        /**
+         * Append the data within a specified range to a byte sink, without copying it into a temporary string.
+         *
+         * @param bytes The byte sink to append to.
+         * @param requested_range The range of addresses to get data from.
+         */
+        void append_data(ByteSink& bytes, const Range& requested_range) const;
+
         /**
          * Debug the blocks within the bank.
          * 
@@ -124,6 +169,9 @@ public:
             Range range;
         };
 
+        /// @brief Blocks keyed by their starting address.
+        using BlockMap = std::map<uint64_t, Block>;
+
         /**
          * Calculate the offset of an address within the bank.
          * 
@@ -132,14 +180,63 @@ public:
          */
         size_t offset(size_t address) const {return address - range.start;}
 
-        /// @brief The memory of the bank.
+        /**
+         * Find the free block that can hold an allocation.
+         * 
+         * @param allowed_range The range of addresses allowed for allocation.
+         * @param alignment The alignment requirement.
+         * @param size The size of the block to allocate.
+         * @param fit How to choose among the free blocks.
+         * @return The free block, or `blocks.end()` if none is large enough.
+         */
+        [[nodiscard]] BlockMap::const_iterator find_free_block(const Range& allowed_range, uint64_t alignment, uint64_t size, Fit fit) const;
+
+        /**
+         * Add a block, updating the free block index.
+         * 
+         * @param allocation The type of allocation for the block.
+         * @param block_range The range of addresses covered by the block.
+         * @return The added block.
+         */
+        BlockMap::iterator insert_block(Allocation allocation, const Range& block_range);
+
+        /**
+         * Remove a block, updating the free block index.
+         * 
+         * @param it The block to remove.
+         */
+        void erase_block(BlockMap::const_iterator it);
+
+        /**
+         * Merge a block with its neighbors if they are adjacent and have the same type of allocation.
+         * 
+         * @param it The block to merge.
+         */
+        void merge_neighbors(BlockMap::iterator it);
+
+        /**
+         * Get the size class of free blocks of a given size.
+         * Blocks in size class `n` are at least 2^n bytes and less than 2^(n+1) bytes long.
+         * 
+         * @param size The size of the block.
+         * @return The size class.
+         */
+        static size_t size_class(uint64_t size);
+
+        /// @brief The memory of the bank, allocated when data is first copied into it.
         std::string memory;
 
         /// @brief The range of addresses covered by the bank.
         Range range;
 
+        /// @brief The byte used to fill free and reserved blocks.
+        uint8_t fill_byte;
+
         /// @brief The blocks within the bank, sorted by starting address.
-        std::list<Block> blocks;
+        BlockMap blocks;
+
+        /// @brief Sizes of the free blocks keyed by their starting address, by size class.
+        std::vector<std::map<uint64_t, uint64_t>> free_blocks;
     };
 
     /// @brief Create an empty memory object.
@@ -70,7 +70,7 @@ void MemoryBody::serialize(std::ostream &stream, const std::string &prefix) cons
 }
 
 
-void MemoryBody::encode(std::string &bytes, const Memory *memory) const {
+void MemoryBody::encode(ByteSink& bytes, const Memory *memory) const {
     if (memory == nullptr) {
         throw Exception("can't encode .memory without memory");
     }
@@ -82,5 +82,5 @@ void MemoryBody::encode(std::string &bytes, const Memory *memory) const {
     auto start_value = start_address.value()->unsigned_value();
     auto end_value = end_address.value()->unsigned_value();
 
-    bytes += (*memory)[bank_value].data(Range(start_value, end_value - start_value + 1));
+    (*memory)[bank_value].append_data(bytes, Range(start_value, end_value - start_value + 1));
 }
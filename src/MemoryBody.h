@@ -40,7 +40,7 @@ public:
 
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<MemoryBody>(bank, start_address, end_address);}
     [[nodiscard]] bool empty() const override {return size().value_or(1) == 0;}
-    void encode(std::string &bytes, const Memory* memory) const override;
+    void encode(ByteSink& bytes, const Memory* memory) const override;
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override;
     void serialize(std::ostream &stream, const std::string &prefix) const override;
 
@@ -151,12 +151,12 @@ SizeRange Object::size_range() const {
 }
 
 
-void Object::evaluate_inner(EvaluationContext& context) {
+bool Object::evaluate_inner(EvaluationContext& context) {
     if (is_reservation()) {
-        reservation_expression->evaluate(context);
+        return reservation_expression->evaluate(context);
     }
     else {
-        body.evaluate(context);
+        return body.evaluate(context);
     }
 }
 
@@ -71,7 +71,7 @@ public:
     Body body;
 
   protected:
-    void evaluate_inner(EvaluationContext &context) override;
+    bool evaluate_inner(EvaluationContext &context) override;
 
   private:
     static const Token token_address;
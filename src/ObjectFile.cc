@@ -34,6 +34,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <algorithm>
 #include <ranges>
 
+#include "BinaryObjectFile.h"
 #include "FileReader.h"
 #include "ObjectExpression.h"
 #include "ParseException.h"
@@ -87,14 +88,22 @@ void ObjectFile::serialize(std::ostream& stream) const {
         stream << std::endl;
     }
 
-    for (const auto& pinned_object : pinned_objects | std::views::values) {
-        stream << ".pin " << pinned_object.name << " " << pinned_object.address;
+    names.clear();
+    for (const auto& name: pinned_objects | std::views::keys) {
+        names.emplace_back(name);
+    }
+    std::ranges::sort(names);
+    for (auto name_ : names) {
+        const auto& pinned_object = pinned_objects.find(name_)->second;
+        stream << ".pin " << pinned_object.name << " " << pinned_object.address << std::endl;
     }
 
     if (!explicitly_used_object_names.empty()) {
+        names.assign(explicitly_used_object_names.begin(), explicitly_used_object_names.end());
+        std::ranges::sort(names);
         stream << ".use";
-        for (const auto& name : explicitly_used_object_names) {
-            stream << " " << name;
+        for (auto name_ : names) {
+            stream << " " << name_;
         }
         stream << std::endl;
     }
@@ -151,6 +160,7 @@ void ObjectFile::add_constant(std::unique_ptr<Constant> constant) {
     if (!own_constant->is_default_only()) {
         add_to_environment(own_constant->name, own_constant->visibility, own_constant->value);
     }
+    added(own_constant);
 }
 
 void ObjectFile::add_object_file(const std::shared_ptr<ObjectFile>& file) {
@@ -225,13 +235,17 @@ void ObjectFile::add_object_file(const std::shared_ptr<ObjectFile>& file) {
         }
     }
     file->pinned_objects.clear();
+    file->evaluation_queue.clear();
 
     if (!ok) {
         throw Exception();
     }
 }
 
-void ObjectFile::collect_constants(std::unordered_set<const Constant*>& set, bool public_only) const {
+void ObjectFile::collect_constants(std::unordered_set<const Constant*>& set, bool public_only) {
+    if (source) {
+        source->materialize_all(ObjectFileParser::token_constant.as_symbol());
+    }
     for (const auto& constant: constants | std::views::values) {
         if (!public_only || constant->is_public()) {
             set.insert(constant.get());
@@ -243,26 +257,34 @@ void ObjectFile::collect_constants(std::unordered_set<const Constant*>& set, boo
 }
 
 void ObjectFile::evaluate() {
+    // Names may have become available through imports or defaults since unresolved entities were last evaluated.
     for (auto& constant : constants | std::views::values) {
-        // TODO: this causes the error for cyclic definition to be printed four times
-        //constant->evaluate();
-        EvaluationResult result;
-        constant->value.evaluate(EvaluationContext(result, constant.get()));
-        constant->process_result(result);
+        if (constant->has_unresolved()) {
+            evaluation_queue.add(constant.get());
+        }
     }
     for (auto& object : objects | std::views::values) {
-        object->evaluate();
+        if (object->has_unresolved()) {
+            evaluation_queue.add(object.get());
+        }
     }
     for (auto& function : functions | std::views::values) {
-        function->evaluate();
+        if (function->has_unresolved()) {
+            evaluation_queue.add(function.get());
+        }
     }
     for (auto& macro : macros | std::views::values) {
-        macro->evaluate();
+        if (macro->has_unresolved()) {
+            evaluation_queue.add(macro.get());
+        }
     }
 
+    evaluation_queue.evaluate();
+
     unresolved_used.clear();
     auto new_explicitly_used_objects = std::unordered_set<Symbol>{};
     for (const auto& symbol : explicitly_used_object_names) {
+        materialize(symbol);
         auto it = objects.find(symbol);
         if (it != objects.end()) {
             explicitly_used_objects.insert(it->second.get());
@@ -298,6 +320,7 @@ void ObjectFile::evaluate() {
                 else {
                     pinned_object->address = Address(pin.address.value()->unsigned_value());
                     explicitly_used_objects.insert(pinned_object);
+                    evaluation_queue.add_dependents(pair.first);
                 }
             }
             else {
@@ -308,6 +331,8 @@ void ObjectFile::evaluate() {
         pinned_objects = new_pinned_objects;
         // TODO: add locations of .pin directives.
         unresolved_used.add(name, {}, result);
+
+        evaluation_queue.evaluate();
     }
 }
 
@@ -315,6 +340,7 @@ void ObjectFile::remove_private_constants() {
     std::erase_if(constants, [this](const auto& item) {
         if (item.second->visibility == Visibility::PRIVATE) {
             private_environment->remove(item.first);
+            evaluation_queue.remove(item.second.get());
             return true;
         }
         return false;
@@ -325,31 +351,36 @@ void ObjectFile::resolve_defaults() {
     for (const auto& [name, constant] : constants) {
         if (constant->is_default_only() && !private_environment->get_variable(name)) {
             add_to_environment(constant->name, constant->visibility, constant->value);
+            evaluation_queue.add_dependents(name);
         }
     }
 
     for (const auto& [name, function] : functions) {
         if (function->is_default_only() && !private_environment->get_function(name)) {
             environment(function->visibility)->add(function->name, function.get());
+            evaluation_queue.add_dependents(name);
         }
     }
 
     for (const auto& [name, macro] : macros) {
         if (macro->is_default_only() && !private_environment->get_macro(name)) {
             environment(macro->visibility)->add(macro->name, macro.get());
+            evaluation_queue.add_dependents(name);
         }
     }
 
     for (const auto& [name, object] : objects) {
         if (object->is_default_only() && !private_environment->get_variable(name)) {
             add_to_environment(object.get());
+            evaluation_queue.add_dependents(name);
         }
     }
 
     unused_default_objects.clear();
 }
 
-const Object* ObjectFile::object(Symbol object_name) const {
+const Object* ObjectFile::object(Symbol object_name) {
+    materialize(object_name);
     auto it = objects.find(object_name);
 
     if (it != objects.end()) {
@@ -379,6 +410,13 @@ ObjectFile::ObjectFile() noexcept {
     private_environment = std::make_shared<Environment>(public_environment);
 }
 
+void ObjectFile::added(Entity* entity) {
+    evaluation_queue.add(entity);
+    if (!entity->is_default_only()) {
+        evaluation_queue.add_dependents(entity->name);
+    }
+}
+
 void ObjectFile::add_to_environment(Object* object) { add_to_environment(object->name, object->visibility, Expression(object->location, object)); }
 
 void ObjectFile::add_to_environment(Symbol symbol_name, Visibility visibility, Expression value) const {
@@ -417,6 +455,7 @@ Object* ObjectFile::insert_object(std::unique_ptr<Object> object) {
         auto own_object = it->second.get();
         own_object->set_owner(this);
         add_to_environment(own_object);
+        added(own_object);
         return own_object;
     }
     else {
@@ -449,6 +488,7 @@ void ObjectFile::add_function(std::unique_ptr<Function> function) {
     if (!function->is_default_only()) {
         environment(function->visibility)->add(function->name, function.get());
     }
+    added(function.get());
     functions[function->name] = std::move(function);
 }
 
@@ -472,9 +512,18 @@ void ObjectFile::add_macro(std::unique_ptr<Macro> macro) {
     if (!macro->is_default_only()) {
         environment(macro->visibility)->add(macro->name, macro.get());
     }
+    added(macro.get());
     macros[macro->name] = std::move(macro);
 }
 
+bool ObjectFile::Constant::evaluate() {
+    // Errors are passed on to the caller instead of being reported here, so they are only reported once.
+    EvaluationResult result;
+    auto changed = value.evaluate(EvaluationContext(result, this));
+    process_result(result);
+    return changed;
+}
+
 void ObjectFile::Constant::serialize(std::ostream& stream) const {
     stream << ".constant " << name << " {" << std::endl;
     serialize_entity(stream);
@@ -501,6 +550,49 @@ void ObjectFile::import(ObjectFile* library) {
     private_environment->add_next(library->public_environment);
 }
 
+bool ObjectFile::materialize(Symbol name) {
+    if (!source) {
+        return false;
+    }
+
+    auto saved_target = Target::current_target;
+    auto found = false;
+    Target::set_current_target(target);
+    try {
+        found = source->materialize(name);
+        if (found) {
+            // Entities parsed only now have not been evaluated with the rest of this file.
+            if (auto it = constants.find(name); it != constants.end()) {
+                it->second->evaluate();
+            }
+            if (auto it = functions.find(name); it != functions.end()) {
+                it->second->evaluate();
+            }
+            if (auto it = macros.find(name); it != macros.end()) {
+                it->second->evaluate();
+            }
+            if (auto it = objects.find(name); it != objects.end()) {
+                it->second->evaluate();
+            }
+        }
+    }
+    catch (...) {
+        Target::set_current_target(saved_target);
+        throw;
+    }
+    Target::set_current_target(saved_target);
+
+    return found;
+}
+
+void ObjectFile::set_source(std::shared_ptr<BinaryObjectFile> new_source) {
+    source = std::move(new_source);
+
+    auto loader = [this](Symbol name) {return materialize(name);};
+    public_environment->loader = loader;
+    private_environment->loader = loader;
+}
+
 void ObjectFile::set_target(const Target* new_target) {
     // TODO: check compatibility
     target = new_target;
@@ -552,6 +644,7 @@ const ObjectFile::Constant* ObjectFile::constant(Symbol name) const {
 }
 
 Macro* ObjectFile::macro(Symbol macro_name) {
+    materialize(macro_name);
     auto it = macros.find(macro_name);
     if (it != macros.end()) {
         return it->second.get();
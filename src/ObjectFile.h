@@ -32,6 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef OBJECT_FILE_H
 #define OBJECT_FILE_H
 
+#include "EvaluationQueue.h"
 #include "Function.h"
 #include "Macro.h"
 #include "Object.h"
@@ -39,6 +40,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Target.h"
 #include "Unresolved.h"
 
+class BinaryObjectFile;
+
 class ObjectFile {
 public:
     class Constant: public Entity {
@@ -46,12 +49,13 @@ public:
         Constant(ObjectFile* owner, const Token& name, Visibility visibility, bool default_only, Expression value): Entity(owner, name, visibility, default_only), value(std::move(value)) {}
         Constant(ObjectFile* owner, const Token& name, const std::shared_ptr<ParsedValue>& definition);
 
+        bool evaluate() override;
         void serialize(std::ostream& stream) const;
 
         Expression value;
 
       protected:
-        void evaluate_inner(EvaluationContext &context) override {value.evaluate(context);}
+        bool evaluate_inner(EvaluationContext &context) override {return value.evaluate(context);}
 
       private:
         static const Token token_value;
@@ -71,7 +75,8 @@ public:
     Object* create_object(Symbol section_name, Visibility visibility, bool default_only, const Token& object_name);
     void evaluate();
     void import(ObjectFile* library);
-    [[nodiscard]] const Object* object(Symbol object_name) const;
+    bool materialize(Symbol name);
+    [[nodiscard]] const Object* object(Symbol object_name);
     [[nodiscard]] Macro* macro(Symbol macro_name);
     [[nodiscard]] UsedEntities public_entities() const;
     void mark_used(Object* object) {explicitly_used_objects.insert(object);}
@@ -80,9 +85,10 @@ public:
     void remove_private_constants();
     void resolve_defaults();
     void serialize(std::ostream& stream) const;
+    void set_source(std::shared_ptr<BinaryObjectFile> new_source);
     void set_target(const Target* new_target);
     std::shared_ptr<Environment> environment(Visibility visibility) const;
-    void collect_constants(std::unordered_set<const Constant*>& set, bool public_only = false) const;
+    void collect_constants(std::unordered_set<const Constant*>& set, bool public_only = false);
 
     std::shared_ptr<Environment> public_environment;
     std::shared_ptr<Environment> private_environment;
@@ -105,6 +111,7 @@ private:
         void process(EvaluationContext context);
     };
 
+    void added(Entity* entity);
     Object* insert_object(std::unique_ptr<Object> object);
     void add_to_environment(const Constant& constant) { add_to_environment(constant.name, constant.visibility, constant.value);}
     void add_to_environment(Object* object);
@@ -122,6 +129,11 @@ private:
     Unresolved unresolved_used;
 
     std::unordered_set<ObjectFile*> imported_libraries;
+
+    EvaluationQueue evaluation_queue;
+
+    // Entities not parsed yet, for libraries read from binary files.
+    std::shared_ptr<BinaryObjectFile> source;
 };
 
 std::ostream& operator<<(std::ostream& stream, const ObjectFile& list);
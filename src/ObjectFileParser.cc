@@ -35,6 +35,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsedValue.h"
 #include "ParseException.h"
 #include "ExpressionParser.h"
+#include "SequenceTokenizer.h"
 
 const Token ObjectFileParser::token_constant = Token(Token::DIRECTIVE, "constant");
 const Token ObjectFileParser::token_format_version = Token(Token::DIRECTIVE, "format_version");
@@ -85,6 +86,41 @@ std::shared_ptr<ObjectFile> ObjectFileParser::parse(Symbol filename) {
     return file;
 }
 
+void ObjectFileParser::parse(const std::shared_ptr<ObjectFile>& object_file, std::vector<Token> tokens) {
+    auto sequence = SequenceTokenizer(std::move(tokens));
+
+    file = object_file;
+    input = &sequence;
+    try {
+        while (!sequence.ended()) {
+            sequence.skip(Token::NEWLINE);
+            auto token = sequence.expect(group_directive, group_directive);
+            if (!token) {
+                break;
+            }
+            parse_directive(token);
+        }
+    }
+    catch (...) {
+        file.reset();
+        input = &tokenizer;
+        throw;
+    }
+    file.reset();
+    input = &tokenizer;
+}
+
+std::vector<Token> ObjectFileParser::tokenize(Symbol filename, Blob text) {
+    auto tokens = std::vector<Token>{};
+
+    tokenizer.push(filename, std::move(text));
+    while (auto token = tokenizer.next()) {
+        tokens.emplace_back(token);
+    }
+
+    return tokens;
+}
+
 void ObjectFileParser::parse_directive(const Token &directive) {
     auto it = parser_methods.find(directive.as_symbol());
     if (it != parser_methods.end()) {
@@ -93,8 +129,8 @@ void ObjectFileParser::parse_directive(const Token &directive) {
     else {
         auto it_symbol = symbol_parser_methods.find(directive.as_symbol());
         if (it_symbol != symbol_parser_methods.end()) {
-            auto name = tokenizer.expect(Token::NAME, TokenGroup::newline);
-            (this->*it_symbol->second)(name, ParsedValue::parse(tokenizer));
+            auto name = input->expect(Token::NAME, TokenGroup::newline);
+            (this->*it_symbol->second)(name, ParsedValue::parse(*input));
         }
         else {
             throw ParseException(directive, "unknown directive");
@@ -111,15 +147,23 @@ void ObjectFileParser::parse_constant(const Token& name, const std::shared_ptr<P
 void ObjectFileParser::parse_object(const Token& name, const std::shared_ptr<ParsedValue>& definition) { file->add_object(std::make_unique<Object>(file.get(), name, definition)); }
 
 void ObjectFileParser::parse_pin() {
-    auto name = tokenizer.expect(Token::NAME);
-    auto address = ExpressionParser(tokenizer).parse();
+    auto name = input->expect(Token::NAME);
+    auto address = ExpressionParser(*input).parse();
 
     file->pin(name.as_symbol(), address);
 }
 
 void ObjectFileParser::parse_format_version() {
-    auto token = tokenizer.expect(Token::VALUE);
-    // TODO: implement
+    auto token = input->expect(Token::VALUE);
+    auto version = token.as_value();
+
+    if (!version.is_number()) {
+        throw ParseException(token, "invalid format version");
+    }
+    auto major = static_cast<unsigned int>(version.float_value());
+    if (major != ObjectFile::format_version_major) {
+        throw ParseException(token, "unsupported format version %u", major);
+    }
 }
 
 void ObjectFileParser::parse_function(const Token& name, const std::shared_ptr<ParsedValue>& definition) {
@@ -127,7 +171,7 @@ void ObjectFileParser::parse_function(const Token& name, const std::shared_ptr<P
 }
 
 void ObjectFileParser::parse_target() {
-    auto name = tokenizer.expect(Token::STRING, TokenGroup::newline);
+    auto name = input->expect(Token::STRING, TokenGroup::newline);
 
     auto target = &Target::get(name.as_symbol());
     Target::set_current_target(target);
@@ -136,7 +180,7 @@ void ObjectFileParser::parse_target() {
 
 void ObjectFileParser::parse_use() {
     while (true) {
-        auto token = tokenizer.next();
+        auto token = input->next();
         if (!token.is_name()) {
             if (token && !token.is_newline()) {
                 throw ParseException(token, "expected newline");
@@ -156,7 +200,7 @@ void ObjectFileParser::parse_import() {
     auto first = true;
 
     while (true) {
-        auto token = tokenizer.next();
+        auto token = input->next();
         if (!token || token.is_newline()) {
             break;
         }
@@ -167,7 +211,7 @@ void ObjectFileParser::parse_import() {
             if (token != Token::comma) {
                 throw ParseException(token, "expected ','");
             }
-            token = tokenizer.next();
+            token = input->next();
         }
         if (!token.is_string()) {
             throw ParseException(token, "expected string");
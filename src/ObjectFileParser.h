@@ -41,9 +41,16 @@ public:
     ObjectFileParser();
 
     std::shared_ptr<ObjectFile> parse(Symbol filename);
+    void parse(const std::shared_ptr<ObjectFile>& object_file, std::vector<Token> tokens);
+    std::vector<Token> tokenize(Symbol filename, Blob text);
 
+    static const Token token_constant;
+    static const Token token_format_version;
+    static const Token token_function;
     static const Token token_in_range;
     static const Token token_label_offset;
+    static const Token token_macro;
+    static const Token token_object;
     static const Token token_object_name;
 
 protected:
@@ -51,6 +58,7 @@ protected:
 
 private:
     std::shared_ptr<ObjectFile> file;
+    Tokenizer* input{&tokenizer};
 
     void parse_constant(const Token& name, const std::shared_ptr<ParsedValue>& definition);
     void parse_format_version();
@@ -64,12 +72,7 @@ private:
 
     static const std::unordered_map<Symbol, void (ObjectFileParser::*)()> parser_methods;
     static const std::unordered_map<Symbol, void (ObjectFileParser::*)(const Token& name, const std::shared_ptr<ParsedValue>& definition)> symbol_parser_methods;
-    static const Token token_constant;
-    static const Token token_format_version;
-    static const Token token_function;
     static const Token token_import;
-    static const Token token_macro;
-    static const Token token_object;
     static const Token token_pin;
     static const Token token_target;
     static const Token token_use;
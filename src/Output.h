@@ -41,7 +41,7 @@ public:
     Body body;
 
 protected:
-  void evaluate_inner(EvaluationContext& context) override {}; // TODO: implement
+  bool evaluate_inner(EvaluationContext& context) override {return false;}; // TODO: implement
 
 private:
   static Token token_output;
@@ -32,6 +32,8 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef PARSER_EXCEPTION_H
 #define PARSER_EXCEPTION_H
 
+#include <vector>
+
 #include "Exception.h"
 
 #include "Location.h"
@@ -33,16 +33,13 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParseException.h"
 #include "BodyParser.h"
 
-bool ParsedValue::initialized = false;
+std::once_flag ParsedValue::initialized;
 TokenGroup ParsedValue::start_group;
 
 void ParsedValue::initialize() {
-    if (!initialized) {
-
+    std::call_once(initialized, [] {
         start_group = TokenGroup({}, {Token::less, Token::colon, Token::curly_open, Token::square_open}, "object start");
-
-        initialized = true;
-    }
+    });
 }
 
 
@@ -32,6 +32,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef PARSED_VALUE_H
 #define PARSED_VALUE_H
 
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -77,7 +78,7 @@ public:
 
 protected:
     static void initialize();
-    static bool initialized;
+    static std::once_flag initialized;
     static TokenGroup start_group;
 };
 
@@ -0,0 +1,54 @@
+/*
+PersistentSymbolSet.cc -- immutable set of symbols sharing structure with the sets derived from it
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "PersistentSymbolSet.h"
+
+#include <algorithm>
+
+PersistentSymbolSet PersistentSymbolSet::adding(Symbol symbol) const {
+    return PersistentSymbolSet(std::make_shared<const Frame>(std::vector<Symbol>{symbol}, frame));
+}
+
+PersistentSymbolSet PersistentSymbolSet::adding(const std::vector<Symbol>& symbols) const {
+    if (symbols.empty()) {
+        return *this;
+    }
+    return PersistentSymbolSet(std::make_shared<const Frame>(symbols, frame));
+}
+
+bool PersistentSymbolSet::contains(Symbol symbol) const {
+    for (auto current = frame.get(); current; current = current->parent.get()) {
+        if (std::ranges::find(current->symbols, symbol) != current->symbols.end()) {
+            return true;
+        }
+    }
+    return false;
+}
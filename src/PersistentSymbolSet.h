@@ -0,0 +1,97 @@
+#ifndef PERSISTENT_SYMBOL_SET_H
+#define PERSISTENT_SYMBOL_SET_H
+
+/*
+PersistentSymbolSet.h -- immutable set of symbols sharing structure with the sets derived from it
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <memory>
+#include <vector>
+
+#include "Symbol.h"
+
+/**
+ * Immutable set of symbols. Adding symbols creates a new set that links to the original one instead of copying it, so deriving a set costs one small allocation.
+ * Lookup walks the chain of additions, which is fine for the short-lived, shallow sets it is meant for.
+ */
+class PersistentSymbolSet {
+  public:
+    PersistentSymbolSet() = default;
+
+    /**
+     * Create a set containing an additional symbol.
+     *
+     * @param symbol The symbol to add.
+     * @return The new set.
+     */
+    [[nodiscard]] PersistentSymbolSet adding(Symbol symbol) const;
+
+    /**
+     * Create a set containing additional symbols.
+     *
+     * @param symbols The symbols to add.
+     * @return The new set.
+     */
+    [[nodiscard]] PersistentSymbolSet adding(const std::vector<Symbol>& symbols) const;
+
+    /**
+     * Check whether the set contains a symbol.
+     *
+     * @param symbol The symbol to check.
+     * @return Whether the symbol is in the set.
+     */
+    [[nodiscard]] bool contains(Symbol symbol) const;
+
+    /**
+     * Check whether the set is empty.
+     *
+     * @return Whether the set is empty.
+     */
+    [[nodiscard]] bool empty() const {return !frame;}
+
+  private:
+    /// @brief Symbols added in one step.
+    class Frame {
+      public:
+        Frame(std::vector<Symbol> symbols, std::shared_ptr<const Frame> parent): symbols(std::move(symbols)), parent(std::move(parent)) {}
+
+        /// @brief The symbols added.
+        std::vector<Symbol> symbols;
+        /// @brief The set the symbols were added to.
+        std::shared_ptr<const Frame> parent;
+    };
+
+    explicit PersistentSymbolSet(std::shared_ptr<const Frame> frame): frame(std::move(frame)) {}
+
+    /// @brief The most recent addition, nullptr for the empty set.
+    std::shared_ptr<const Frame> frame;
+};
+
+#endif // PERSISTENT_SYMBOL_SET_H
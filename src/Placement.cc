@@ -0,0 +1,336 @@
+/*
+Placement.cc -- assign addresses to objects
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "Placement.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <set>
+
+#include "Object.h"
+
+const std::vector<Placement::Strategy> Placement::strategies = {FIRST_FIT, BEST_FIT, DECREASING, SEARCH};
+
+bool Placement::Result::better_than(const Result& other) const {
+    if (failed != other.failed) {
+        return failed < other.failed;
+    }
+    return wasted < other.wasted;
+}
+
+Placement::Placement(Memory memory, std::vector<Object*> objects): memory(std::move(memory)), objects(std::move(objects)) {
+    addresses.resize(this->objects.size());
+}
+
+Placement::Result Placement::place(Strategy strategy) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = Result(strategy);
+
+    switch (strategy) {
+        case FIRST_FIT:
+            place_in_order(link_order(), Memory::FIRST_FIT);
+            break;
+
+        case BEST_FIT:
+            place_in_order(link_order(), Memory::BEST_FIT);
+            break;
+
+        case DECREASING:
+            place_in_order(decreasing_order(), Memory::FIRST_FIT);
+            break;
+
+        case SEARCH:
+            search(result);
+            break;
+    }
+
+    for (const auto& address: addresses) {
+        if (address) {
+            result.placed += 1;
+        }
+        else {
+            result.failed += 1;
+        }
+    }
+    result.wasted = wasted_size(memory);
+    result.duration = std::chrono::steady_clock::now() - start;
+    return result;
+}
+
+void Placement::report(std::ostream& stream, const std::vector<Result>& results) {
+    stream << std::left << std::setw(12) << "strategy" << std::right << std::setw(8) << "placed" << std::setw(8) << "failed" << std::setw(8) << "wasted" << std::setw(12) << "time" << std::endl;
+    for (const auto& result: results) {
+        auto milliseconds = std::chrono::duration<double, std::milli>(result.duration).count();
+        stream << std::left << std::setw(12) << name(result.strategy) << std::right << std::setw(8) << result.placed << std::setw(8) << result.failed << std::setw(8) << result.wasted << std::setw(10) << std::fixed << std::setprecision(3) << milliseconds << "ms";
+        if (result.strategy == SEARCH) {
+            stream << " (" << result.nodes << " nodes" << (result.limited ? ", limit reached" : "") << ")";
+        }
+        stream << std::endl;
+    }
+}
+
+std::optional<Placement::Strategy> Placement::strategy(const std::string& name) {
+    for (auto strategy: strategies) {
+        if (name == Placement::name(strategy)) {
+            return strategy;
+        }
+    }
+    return {};
+}
+
+const char* Placement::name(Strategy strategy) {
+    switch (strategy) {
+        case FIRST_FIT:
+            return "first-fit";
+        case BEST_FIT:
+            return "best-fit";
+        case DECREASING:
+            return "decreasing";
+        case SEARCH:
+            return "search";
+    }
+    return "unknown";
+}
+
+std::vector<size_t> Placement::link_order() const {
+    auto order = std::vector<size_t>(objects.size());
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+std::vector<size_t> Placement::decreasing_order() const {
+    auto order = link_order();
+    std::ranges::stable_sort(order, [this](size_t a, size_t b) {
+        auto object_a = objects[a];
+        auto object_b = objects[b];
+        auto alignment_a = std::max(object_a->alignment, uint64_t{1});
+        auto alignment_b = std::max(object_b->alignment, uint64_t{1});
+        if (alignment_a != alignment_b) {
+            return alignment_a > alignment_b;
+        }
+        return *object_a->size_range().size() > *object_b->size_range().size();
+    });
+    return order;
+}
+
+void Placement::place_in_order(const std::vector<size_t>& order, Memory::Fit fit) {
+    for (auto index: order) {
+        addresses[index] = allocate(memory, objects[index], fit);
+    }
+}
+
+void Placement::search(Result& result) {
+    auto state = Search();
+
+    // Start from the best heuristic placement, so the search never does worse.
+    for (auto strategy: {FIRST_FIT, BEST_FIT, DECREASING}) {
+        auto trial = Placement(memory, objects);
+        auto trial_result = trial.place(strategy);
+        if (!state.best_memory || trial_result.better_than(state.best)) {
+            state.best = trial_result;
+            state.best_memory = std::move(trial.memory);
+            state.best_addresses = std::move(trial.addresses);
+        }
+    }
+
+    state.order = decreasing_order();
+    state.ranges = section_ranges();
+    state.addresses.resize(objects.size());
+    if (time_limit) {
+        state.deadline = std::chrono::steady_clock::now() + *time_limit;
+    }
+    search_from(state, 0, memory, 0);
+
+    memory = std::move(*state.best_memory);
+    addresses = std::move(state.best_addresses);
+    result.nodes = state.nodes;
+    result.limited = state.limited;
+}
+
+void Placement::search_from(Search& state, size_t position, const Memory& current, size_t failed) {
+    if (done(state, failed + minimum_failures(state, position, current))) {
+        return;
+    }
+    state.nodes += 1;
+    if (state.nodes > node_limit || (time_limit && std::chrono::steady_clock::now() > state.deadline)) {
+        state.limited = true;
+        return;
+    }
+
+    if (position == state.order.size()) {
+        auto wasted = wasted_size(current);
+        if (failed < state.best.failed || (failed == state.best.failed && wasted < state.best.wasted)) {
+            state.best.failed = failed;
+            state.best.wasted = wasted;
+            state.best_memory = current;
+            state.best_addresses = state.addresses;
+        }
+        return;
+    }
+
+    auto index = state.order[position];
+    auto object = objects[index];
+    auto object_candidates = candidates(current, object);
+    if (object_candidates.empty()) {
+        state.addresses[index] = {};
+        search_from(state, position + 1, current, failed + 1);
+        return;
+    }
+
+    for (const auto& candidate: object_candidates) {
+        auto next = current;
+        allocate_at(next, object, candidate);
+        state.addresses[index] = candidate;
+        search_from(state, position + 1, next, failed);
+        if (done(state, failed)) {
+            return;
+        }
+    }
+}
+
+bool Placement::done(const Search& state, size_t failed) const {
+    // Failed objects only accumulate, and no placement wastes less than nothing.
+    return state.limited || failed > state.best.failed || (failed == state.best.failed && state.best.wasted == 0);
+}
+
+size_t Placement::minimum_failures(const Search& state, size_t position, const Memory& current) const {
+    uint64_t free = 0;
+    for (const auto& [bank, start, size]: state.ranges) {
+        free += current[bank].free_size(Range(start, size));
+    }
+
+    auto sizes = std::vector<uint64_t>();
+    for (auto index = position; index < state.order.size(); index++) {
+        sizes.push_back(*objects[state.order[index]]->size_range().size());
+    }
+    std::ranges::sort(sizes);
+
+    // Even ignoring alignment and fragmentation, only the smallest objects that fit into the free space can be placed.
+    size_t fitting = 0;
+    for (auto size: sizes) {
+        if (size > free) {
+            break;
+        }
+        free -= size;
+        fitting += 1;
+    }
+    return sizes.size() - fitting;
+}
+
+std::vector<Address> Placement::candidates(const Memory& current, const Object* object) const {
+    auto size = *object->size_range().size();
+    auto result = std::vector<Address>();
+    auto add = [&result](uint64_t bank, uint64_t address) {
+        auto candidate = Address(bank, address);
+        if (std::ranges::find(result, candidate) == result.end()) {
+            result.push_back(candidate);
+        }
+    };
+
+    for (auto fit: {Memory::BEST_FIT, Memory::FIRST_FIT}) {
+        for (const auto& block: object->section->blocks) {
+            auto space = current[block.bank].find_free_space(block.range, object->alignment, size, fit);
+            if (!space) {
+                continue;
+            }
+            space->align(object->alignment);
+            add(block.bank, space->start);
+            // Placing the object at the end of the free space keeps alignment padding in front of it usable.
+            auto last = space->end() + 1 - size;
+            auto alignment = std::max(object->alignment, uint64_t{1});
+            last -= last % alignment;
+            if (last > space->start) {
+                add(block.bank, last);
+            }
+        }
+    }
+
+    return result;
+}
+
+uint64_t Placement::wasted_size(const Memory& current) const {
+    uint64_t size = 0;
+    for (const auto& [bank, start, range_size]: section_ranges()) {
+        size += current[bank].fragmented_size(Range(start, range_size));
+    }
+    return size;
+}
+
+std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> Placement::section_ranges() const {
+    // Sections may share blocks, so collect each block only once.
+    auto ranges = std::set<std::tuple<uint64_t, uint64_t, uint64_t>>();
+    for (auto object: objects) {
+        for (const auto& block: object->section->blocks) {
+            ranges.emplace(block.bank, block.range.start, block.range.size);
+        }
+    }
+    return {ranges.begin(), ranges.end()};
+}
+
+std::optional<Address> Placement::allocate(Memory& current, const Object* object, Memory::Fit fit) {
+    auto size = *object->size_range().size();
+    auto allocation = object->is_reservation() ? Memory::RESERVED : Memory::DATA;
+
+    if (fit == Memory::FIRST_FIT) {
+        for (const auto& block: object->section->blocks) {
+            if (auto address = current[block.bank].allocate(block.range, allocation, object->alignment, size)) {
+                return Address(block.bank, *address);
+            }
+        }
+        return {};
+    }
+
+    // Choose the block containing the smallest fitting free space.
+    const MemoryMap::Block* chosen_block = nullptr;
+    uint64_t chosen_size = 0;
+    for (const auto& block: object->section->blocks) {
+        auto space = current[block.bank].find_free_space(block.range, object->alignment, size, fit);
+        if (space && (!chosen_block || space->size < chosen_size)) {
+            chosen_block = &block;
+            chosen_size = space->size;
+        }
+    }
+    if (!chosen_block) {
+        return {};
+    }
+    auto address = current[chosen_block->bank].allocate(chosen_block->range, allocation, object->alignment, size, fit);
+    if (!address) {
+        return {};
+    }
+    return Address(chosen_block->bank, *address);
+}
+
+bool Placement::allocate_at(Memory& current, const Object* object, const Address& address) {
+    auto size = *object->size_range().size();
+    auto allocation = object->is_reservation() ? Memory::RESERVED : Memory::DATA;
+    return current[address.bank].allocate(Range(address.address, size), allocation, 0, size).has_value();
+}
@@ -0,0 +1,173 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+/*
+Placement.h -- assign addresses to objects
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Address.h"
+#include "Memory.h"
+
+class Object;
+
+/**
+ * Assigns addresses to objects without fixed addresses, using one of several strategies.
+ */
+class Placement {
+  public:
+    /// @brief The strategy used to place objects.
+    enum Strategy {
+        FIRST_FIT, ///< Place objects in link order at the lowest free address.
+        BEST_FIT, ///< Place objects in link order in the smallest free block that holds them.
+        DECREASING, ///< Place objects with the largest alignment and size first, at the lowest free address.
+        SEARCH ///< Search for the placement that fits the most objects with the least wasted space.
+    };
+
+    /// @brief How well a strategy did.
+    class Result {
+      public:
+        explicit Result(Strategy strategy): strategy(strategy) {}
+
+        /**
+         * Check whether this result is better than another one: fewer objects failed to place or, failing that, less space was wasted.
+         *
+         * @param other The result to compare to.
+         * @return Whether this result is better.
+         */
+        [[nodiscard]] bool better_than(const Result& other) const;
+
+        /// @brief The strategy used.
+        Strategy strategy;
+        /// @brief Number of objects placed.
+        size_t placed = 0;
+        /// @brief Number of objects that didn't fit.
+        size_t failed = 0;
+        /// @brief Free bytes enclosed by allocated blocks within the sections used.
+        uint64_t wasted = 0;
+        /// @brief Number of partial placements tried by the search.
+        size_t nodes = 0;
+        /// @brief Whether the search was cut short by its limits.
+        bool limited = false;
+        /// @brief Time taken.
+        std::chrono::steady_clock::duration duration{};
+    };
+
+    /**
+     * Create a placement.
+     *
+     * @param memory The memory to place the objects in, with fixed objects already allocated.
+     * @param objects The objects to place, in link order.
+     */
+    Placement(Memory memory, std::vector<Object*> objects);
+
+    /**
+     * Place all objects, allocating them in `memory` and recording their addresses in `addresses`.
+     *
+     * @param strategy The strategy to use.
+     * @return How well the strategy did.
+     */
+    Result place(Strategy strategy);
+
+    /**
+     * Write a table comparing results of different strategies.
+     *
+     * @param stream The stream to write to.
+     * @param results The results to compare.
+     */
+    static void report(std::ostream& stream, const std::vector<Result>& results);
+
+    /**
+     * Get strategy by name.
+     *
+     * @param name The name of the strategy.
+     * @return The strategy, or std::nullopt if there is none with that name.
+     */
+    static std::optional<Strategy> strategy(const std::string& name);
+
+    /**
+     * Get the name of a strategy.
+     *
+     * @param strategy The strategy.
+     * @return The name of the strategy.
+     */
+    static const char* name(Strategy strategy);
+
+    /// @brief All strategies, in order of increasing effort.
+    static const std::vector<Strategy> strategies;
+
+    /// @brief The memory objects are placed in.
+    Memory memory;
+    /// @brief The objects to place.
+    std::vector<Object*> objects;
+    /// @brief The addresses assigned to the objects, std::nullopt for objects that didn't fit.
+    std::vector<std::optional<Address>> addresses;
+
+    /// @brief Maximum number of partial placements the search tries.
+    size_t node_limit = 10000;
+    /// @brief Maximum time the search may take.
+    std::optional<std::chrono::milliseconds> time_limit;
+
+  private:
+    class Search {
+      public:
+        std::vector<size_t> order;
+        std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> ranges;
+        std::vector<std::optional<Address>> addresses;
+        std::chrono::steady_clock::time_point deadline;
+        size_t nodes = 0;
+        bool limited = false;
+
+        Result best{SEARCH};
+        std::optional<Memory> best_memory;
+        std::vector<std::optional<Address>> best_addresses;
+    };
+
+    [[nodiscard]] std::vector<size_t> link_order() const;
+    [[nodiscard]] std::vector<size_t> decreasing_order() const;
+    void place_in_order(const std::vector<size_t>& order, Memory::Fit fit);
+    void search(Result& result);
+    void search_from(Search& state, size_t position, const Memory& current, size_t failed);
+    [[nodiscard]] bool done(const Search& state, size_t failed) const;
+    [[nodiscard]] size_t minimum_failures(const Search& state, size_t position, const Memory& current) const;
+    [[nodiscard]] std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> section_ranges() const;
+    [[nodiscard]] std::vector<Address> candidates(const Memory& current, const Object* object) const;
+    [[nodiscard]] uint64_t wasted_size(const Memory& current) const;
+    static std::optional<Address> allocate(Memory& current, const Object* object, Memory::Fit fit);
+    static bool allocate_at(Memory& current, const Object* object, const Address& address);
+};
+
+#endif // PLACEMENT_H
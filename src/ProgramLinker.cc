@@ -32,45 +32,57 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProgramLinker.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cinttypes>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <thread>
 
 #include "Assembler.h"
+#include "ContentHash.h"
 #include "Exception.h"
 #include "FileReader.h"
+#include "LinkCache.h"
+#include "Statistics.h"
 
 void ProgramLinker::link_sub() {
     memory = target->map.initialize_memory();
 
+    auto phase = Statistics::Phase(Statistics::global, "import libraries");
     for (auto& library: libraries) {
         library->evaluate();
         program->import(library.get());
     }
 
+    phase.next("evaluate");
     Target::set_current_target(target);
     program->resolve_defaults();
     program->evaluate();
-    program->evaluate();
-    program->evaluate();
 
+    phase.next("check unresolved");
     Unresolved unresolved;
     if (!program->check_unresolved(unresolved)) {
         unresolved.report();
         throw Exception();
     }
 
+    phase.next("evaluate");
     Target::set_current_target(target);
     target->object_file->import(program.get());
     target->object_file->resolve_defaults();
     target->object_file->evaluate();
-    target->object_file->evaluate();
 
+    phase.next("check unresolved");
     if (!target->object_file->check_unresolved(unresolved)) {
         unresolved.report();
         throw Exception();
     }
 
+    phase.next("evaluate");
+
     EvaluationResult result;
     auto environment = std::make_shared<Environment>();
     environment->add_next(target->object_file->private_environment);
@@ -89,6 +101,7 @@ void ProgramLinker::link_sub() {
         throw Exception();
     }
 
+    phase.next("collect objects");
     std::unordered_set<Object*> new_objects = result.used_objects;
     target->object_file->collect_explicitly_used_objects(new_objects);
     // TODO: warn/error if no used objects?
@@ -108,8 +121,10 @@ void ProgramLinker::link_sub() {
         }
     }
 
+    phase.next("placement");
     auto sorted_objects = std::vector<Object*>(objects.begin(), objects.end());
     std::ranges::sort(sorted_objects, Object::less_pointers);
+    auto placed_objects = std::vector<Object*>();
     for (auto object: sorted_objects) {
         if (!object->size_range().size()) {
             FileReader::global.error({}, "object '%s' has unknown size", object->name.c_str());
@@ -126,51 +141,189 @@ void ProgramLinker::link_sub() {
             }
         }
         else {
-            for (const auto& block : object->section->blocks) {
-                auto address = memory[block.bank].allocate(block.range, object->is_reservation() ? Memory::RESERVED : Memory::DATA, object->alignment, *object->size_range().size());
-                if (address.has_value()) {
-                    object->address = {block.bank, *address};
-                    break;
-                }
+            placed_objects.push_back(object);
+        }
+    }
+
+    auto cache = std::optional<LinkCache>();
+    auto placement = std::optional<Placement>();
+    if (incremental_link) {
+        // Objects that haven't changed keep their address from the previous link, only the others are placed.
+        auto definitions_hash = ContentHash();
+        for (auto file: target->files) {
+            auto contents = FileReader::global.read(file).view();
+            definitions_hash.add(static_cast<uint64_t>(contents.size()));
+            definitions_hash.add(contents);
+        }
+        cache.emplace(*incremental_link, target->name, definitions_hash.value());
+        auto kept_memory = memory;
+        auto kept_objects = std::vector<std::pair<Object*, Address>>();
+        auto changed_objects = std::vector<Object*>();
+        for (auto object: placed_objects) {
+            auto address = cache->address(object);
+            auto size = *object->size_range().size();
+            if (address && kept_memory[address->bank].allocate(Range(address->address, size), object->is_reservation() ? Memory::RESERVED : Memory::DATA, 0, size)) {
+                kept_objects.emplace_back(object, *address);
             }
-            if (!object->address) {
-                FileReader::global.error({}, "no space left for %s ($%" PRIx64 " bytes) in section %s", object->name.c_str(), *object->size_range().size(), object->section->name.c_str());
-                continue;
+            else {
+                changed_objects.push_back(object);
+            }
+        }
+        if (!kept_objects.empty()) {
+            auto trial = Placement(kept_memory, changed_objects);
+            trial.time_limit = placement_time_limit;
+            // Kept objects may leave too little space for changed ones, all objects are placed anew then.
+            if (trial.place(placement_strategy).failed == 0) {
+                for (const auto& [object, address]: kept_objects) {
+                    object->address = address;
+                    cache->add(object);
+                }
+                memory = std::move(kept_memory);
+                placed_objects = std::move(changed_objects);
+                placement = std::move(trial);
             }
         }
     }
 
+    if (placement_report) {
+        auto results = std::vector<Placement::Result>();
+        for (auto strategy: Placement::strategies) {
+            auto trial = Placement(memory, placed_objects);
+            trial.time_limit = placement_time_limit;
+            results.push_back(trial.place(strategy));
+        }
+        Placement::report(std::cout, results);
+    }
+
+    if (!placement) {
+        placement.emplace(memory, placed_objects);
+        placement->time_limit = placement_time_limit;
+        placement->place(placement_strategy);
+    }
+    memory = std::move(placement->memory);
+    for (size_t index = 0; index < placed_objects.size(); index++) {
+        auto object = placed_objects[index];
+        object->address = placement->addresses[index];
+        if (!object->address) {
+            FileReader::global.error({}, "no space left for %s ($%" PRIx64 " bytes) in section %s", object->name.c_str(), *object->size_range().size(), object->section->name.c_str());
+        }
+        else if (cache) {
+            cache->add(object);
+        }
+    }
+
     if (FileReader::global.had_error()) {
         return;
     }
 
+    phase.next("evaluate objects");
     Target::set_current_target(target);
 
-    for (auto object: objects) {
+    auto encoded_objects = std::vector<EncodedObject>(sorted_objects.size());
+    if (cache) {
+        // Digests must be computed before any object is evaluated, since evaluation changes their serialization.
+        for (size_t index = 0; index < sorted_objects.size(); index++) {
+            if (!sorted_objects[index]->is_reservation()) {
+                encoded_objects[index].digest = cache->digest(sorted_objects[index]);
+            }
+        }
+    }
+
+    // Evaluation shares environments between objects, so only encoding runs in parallel.
+    for (size_t index = 0; index < sorted_objects.size(); index++) {
+        auto& encoded_object = encoded_objects[index];
+        if (encoded_object.digest) {
+            if (auto bytes = cache->bytes(sorted_objects[index], *encoded_object.digest)) {
+                // Unchanged objects are copied from the cache without evaluating them.
+                auto region = memory[sorted_objects[index]->address->bank].region(Range(sorted_objects[index]->address->address, bytes->size()));
+                std::ranges::copy(*bytes, region.begin());
+                encoded_object.region = region;
+                encoded_object.reused = true;
+                continue;
+            }
+        }
         try {
-            object->evaluate();
-            if (!object->is_reservation()) {
-                std::string bytes;
-                bytes.reserve(*object->size_range().size());
+            sorted_objects[index]->evaluate();
+        }
+        catch (Exception& ex) {
+            encoded_objects[index].error = ex.what();
+            continue;
+        }
+        // Objects are encoded directly into their space in memory, which must be allocated before encoding starts.
+        if (!sorted_objects[index]->is_reservation()) {
+            try {
+                encoded_objects[index].region = memory[sorted_objects[index]->address->bank].region(Range(sorted_objects[index]->address->address, *sorted_objects[index]->size_range().size()));
+            }
+            catch (Exception& ex) {
+                encoded_objects[index].error = ex.what();
+            }
+        }
+    }
+
+    phase.next("encode");
+    encode_objects(sorted_objects, encoded_objects);
+
+    if (cache) {
+        for (size_t index = 0; index < sorted_objects.size(); index++) {
+            const auto& encoded_object = encoded_objects[index];
+            if (encoded_object.digest && !encoded_object.error) {
+                cache->add_bytes(sorted_objects[index], *encoded_object.digest, std::string_view(encoded_object.region.data(), encoded_object.region.size()));
+            }
+        }
+    }
+
+    for (size_t index = 0; index < sorted_objects.size(); index++) {
+        auto object = sorted_objects[index];
+        auto& encoded_object = encoded_objects[index];
+        Statistics::global.add_object(object->name.str(), object->evaluations, *object->size_range().size());
+        if (encoded_object.error) {
+            FileReader::global.error(Location(), "can't encode '%s': %s", object->name.c_str(), encoded_object.error->c_str());
+            if (FileReader::global.verbose_error_messages) {
+                std::cout << object->body;
+            }
+        }
+    }
+
+    if (cache && !FileReader::global.had_error()) {
+        cache->write();
+    }
+}
+
+void ProgramLinker::encode_objects(const std::vector<Object*>& sorted_objects, std::vector<EncodedObject>& encoded_objects) const {
+    auto next = std::atomic<size_t>(0);
+    auto encode = [&]() {
+        Target::set_current_target(target);
+        size_t index;
+        while ((index = next++) < sorted_objects.size()) {
+            auto object = sorted_objects[index];
+            auto& encoded_object = encoded_objects[index];
+            if (encoded_object.error || encoded_object.reused || object->is_reservation()) {
+                continue;
+            }
+            try {
+                auto bytes = ByteSink(encoded_object.region);
                 object->body.encode(bytes);
                 if (bytes.size() != object->size_range().size()) {
                     std::stringstream str;
                     str << "internal error: encoded size (" << bytes.size() << ") != expected object size (" << *object->size_range().size() << ")";
                     throw Exception(str.str());
                 }
-                memory[object->address->bank].copy(object->address->address, bytes);
             }
-        }
-        catch (Exception& ex) {
-            FileReader::global.error(Location(), "can't encode '%s': %s", object->name.c_str(), ex.what());
-            if (FileReader::global.verbose_error_messages) {
-                std::cout << object->body;
+            catch (Exception& ex) {
+                encoded_object.error = ex.what();
             }
         }
+    };
+
+    auto workers = std::vector<std::jthread>();
+    for (size_t i = 1; i < std::min(jobs, sorted_objects.size()); i++) {
+        workers.emplace_back(encode);
     }
+    encode();
 }
 
 void ProgramLinker::output(const std::string &file_name) {
+    auto phase = Statistics::Phase(Statistics::global, "output");
     auto environment = std::make_shared<Environment>();
 
     for (const auto& object: objects) {
@@ -179,7 +332,7 @@ void ProgramLinker::output(const std::string &file_name) {
         }
     }
 
-    // TODO: support for multiple banks
+    // .data_start, .data_end and .data_size describe bank 0 only, no target uses more than one bank yet. Other banks can be written with an explicit .memory bank, start, end.
     auto data_range = memory[0].data_range();
 
     environment->add(Assembler::token_data_end.as_symbol(), Expression({}, data_range.end()));
@@ -192,20 +345,51 @@ void ProgramLinker::output(const std::string &file_name) {
     output_body.evaluate(EvaluationContext(result, EvaluationContext::OUTPUT, environment, target->defines, SizeRange()));
     // TODO: process result
 
-    auto bytes = std::string();
-    bytes.reserve(output_body.size_range().minimum);
+    // Output is streamed to the file as it is encoded, checksums are patched in afterward.
+    auto error = std::error_code();
+    auto status = std::filesystem::status(file_name, error);
+    auto created = !std::filesystem::exists(status);
+    auto seekable = created || std::filesystem::is_regular_file(status);
+    auto stream = std::fstream(file_name, seekable ? std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc : std::ios::binary | std::ios::out);
+    if (!stream) {
+        throw Exception("can't create '%s': %s", file_name.c_str(), strerror(errno));
+    }
 
-    output_body.encode(bytes, &memory);
+    try {
+        if (seekable || result.checksums.empty()) {
+            auto bytes = ByteSink(stream);
+            output_body.encode(bytes, &memory);
 
-    for (const auto& checksum: result.checksums) {
-        checksum.compute(bytes);
-    }
+            phase.next("checksums");
+            ChecksumComputation::compute(stream, result.checksums);
+        }
+        else {
+            // Checksums are read back from the output, so output that can't seek, like a pipe, is buffered.
+            auto buffer = std::stringstream(std::ios::binary | std::ios::in | std::ios::out);
+            auto bytes = ByteSink(buffer);
+            output_body.encode(bytes, &memory);
+
+            phase.next("checksums");
+            ChecksumComputation::compute(buffer, result.checksums);
+            buffer.seekg(0);
+            stream << buffer.rdbuf();
+        }
 
-    auto stream = std::ofstream(file_name, std::ios::binary);
-    stream << bytes;
+        stream.close();
+        if (stream.fail()) {
+            throw Exception("can't write '%s': %s", file_name.c_str(), strerror(errno));
+        }
+    }
+    catch (...) {
+        stream.close();
+        // Only remove a file this run created, never a device like /dev/stdout or a file that existed before.
+        if (created && std::filesystem::is_regular_file(file_name, error)) {
+            std::filesystem::remove(file_name, error);
+        }
+        throw;
+    }
 }
 
-
 void ProgramLinker::output_symbol_map(const std::string& file_name) {
     auto sorted_objects = std::vector<Object*>(objects.begin(), objects.end());
     std::ranges::sort(sorted_objects, Object::less_pointers);
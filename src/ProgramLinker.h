@@ -32,18 +32,41 @@ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
 IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <chrono>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
 #include "Linker.h"
+#include "Placement.h"
 
 class ProgramLinker: public Linker {
   public:
     void output(const std::string& file_name) override;
     void output_symbol_map(const std::string& file_name);
 
+    Placement::Strategy placement_strategy = Placement::FIRST_FIT;
+    std::optional<std::chrono::milliseconds> placement_time_limit;
+    bool placement_report = false;
+    size_t jobs = 1; // Number of threads encoding objects.
+    std::optional<std::string> incremental_link; // File keeping addresses and encoded bytes of objects between links.
+
   protected:
     void link_sub() override;
     UsedEntities roots() override;
 
   private:
+    class EncodedObject {
+    public:
+        std::span<char> region;
+        std::optional<std::string> error;
+        std::optional<uint64_t> digest; // Set when linking incrementally.
+        bool reused = false; // Copied from the link cache, not encoded.
+    };
+
+    void encode_objects(const std::vector<Object*>& sorted_objects, std::vector<EncodedObject>& encoded_objects) const;
+
     Body output_body;
     Memory memory;
 };
@@ -31,39 +31,67 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RepeatBody.h"
 
-Body RepeatBody::create(Symbol variable, const std::optional<Expression>& start, const Expression& end, const Body& body) {
+Body RepeatBody::create(Symbol variable, const std::optional<Expression>& start, const Expression& end, const Body& body, const EvaluationContext* context) {
     auto scoped_body = body.scoped();
-    if ((!start || start.has_value()) && end.has_value()) {
-        auto expanded_body = Body();
-        auto step = Value(static_cast<uint64_t>(1));
-        auto environment = std::make_shared<Environment>();
-        auto result = EvaluationResult();
-        auto context = EvaluationContext(result, EvaluationContext::ARGUMENTS, environment);
-        for (auto index = start ? *start->value() : Value(static_cast<uint64_t>(0)); index < *end.value(); index += step) {
-            if (variable) {
-                environment->add(variable, Expression({}, index));
-                auto new_body = scoped_body.evaluated(context);
-                // TODO: handle result
-                expanded_body.append(new_body ? *new_body : body);
-            }
-            else {
-                expanded_body.append(scoped_body);
-            }
-        }
-        return expanded_body;
+    auto repeat = std::make_shared<RepeatBody>(variable, start, end, scoped_body);
+
+    if (!repeat->is_rolled()) {
+        return Body(repeat);
     }
-    else {
-        return Body(std::make_shared<RepeatBody>(variable, start, end, scoped_body));
+    if (scoped_body.depends_on_position()) {
+        // Labels need distinct offsets in each iteration.
+        return unrolled(variable, start, end, body, scoped_body);
+    }
+
+    auto iterations = uint64_t{0};
+    repeat->for_each_index([&iterations](const Value&) {iterations += 1;});
+    if (iterations == 0) {
+        return {};
+    }
+
+    if (context || scoped_body.size()) {
+        // Otherwise the size is determined when the containing object is evaluated.
+        repeat->size_range_ = repeat->iterations_size(context);
     }
+    return Body(repeat);
+}
+
+void RepeatBody::encode(ByteSink& bytes, const Memory* memory) const {
+    if (!is_rolled()) {
+        throw Exception("unresolved repeat");
+    }
+
+    auto environment = std::make_shared<Environment>();
+    auto result = EvaluationResult();
+    auto context = EvaluationContext(result, EvaluationContext::STANDALONE, environment);
+    for_each_index([&](const Value& index) {
+        if (variable) {
+            environment->add(variable, Expression({}, index));
+        }
+        auto iteration = body.evaluated(context);
+        (iteration ? *iteration : body).encode(bytes, memory);
+    });
 }
 
 std::optional<Body> RepeatBody::evaluated(const EvaluationContext& context) const {
     auto new_start = start ? start->evaluated(context) : std::optional<Expression>{};
     auto new_end = end.evaluated(context);
-    auto new_body = body.evaluated(context);
+    auto new_body = variable ? body.evaluated(context.skipping_variables({variable})) : body.evaluated(context);
 
-    if (new_start || new_end || new_body) {
-        return create(variable, new_start ? new_start : start, new_end ? *new_end : end, new_body ? *new_body : body);
+    if (is_rolled() && !new_start && !new_end) {
+        if (!new_body && size()) {
+            // Nothing the iterations depend on has changed.
+            return {};
+        }
+        auto repeat = std::make_shared<RepeatBody>(variable, start, end, new_body ? *new_body : body);
+        repeat->size_range_ = repeat->iterations_size(&context);
+        if (!new_body && repeat->size_range_ == size_range_) {
+            return {};
+        }
+        return Body(repeat);
+    }
+    else if (new_start || new_end || new_body) {
+        return create(variable, new_start ? new_start : start, new_end ? *new_end : end, new_body ? *new_body : body, &context);
     }
     else {
         return {};
@@ -80,5 +108,54 @@ void RepeatBody::serialize(std::ostream& stream, const std::string& prefix) cons
     }
     stream << end << " {" << std::endl;
     body.serialize(stream, prefix + "  ");
-    stream << "}" << std::endl;
+    stream << prefix << "}" << std::endl;
+}
+
+void RepeatBody::for_each_index(const std::function<void(const Value& index)>& function) const {
+    auto step = Value(static_cast<uint64_t>(1));
+    for (auto index = start ? *start->value() : Value(static_cast<uint64_t>(0)); index < *end.value(); index += step) {
+        function(index);
+    }
+}
+
+SizeRange RepeatBody::iterations_size(const EvaluationContext* context) const {
+    if (auto size = body.size()) {
+        // The size doesn't depend on the index.
+        auto iterations = uint64_t{0};
+        for_each_index([&iterations](const Value&) {iterations += 1;});
+        return SizeRange(*size * iterations);
+    }
+
+    auto environment = context ? std::make_shared<Environment>(context->environment) : std::make_shared<Environment>();
+    auto result = EvaluationResult();
+    auto iteration_context = context ? context->adding_scope(environment, context->offset) : EvaluationContext(result, EvaluationContext::ARGUMENTS, environment);
+    auto size = SizeRange(0);
+    for_each_index([&](const Value& index) {
+        if (variable) {
+            environment->add(variable, Expression({}, index));
+        }
+        auto iteration = body.evaluated(iteration_context);
+        size += (iteration ? *iteration : body).size_range();
+    });
+    return size;
+}
+
+Body RepeatBody::unrolled(Symbol variable, const std::optional<Expression>& start, const Expression& end, const Body& body, const Body& scoped_body) {
+    auto expanded_body = Body();
+    auto step = Value(static_cast<uint64_t>(1));
+    auto environment = std::make_shared<Environment>();
+    auto result = EvaluationResult();
+    auto context = EvaluationContext(result, EvaluationContext::ARGUMENTS, environment);
+    for (auto index = start ? *start->value() : Value(static_cast<uint64_t>(0)); index < *end.value(); index += step) {
+        if (variable) {
+            environment->add(variable, Expression({}, index));
+            auto new_body = scoped_body.evaluated(context);
+            // TODO: handle result
+            expanded_body.append(new_body ? *new_body : body);
+        }
+        else {
+            expanded_body.append(scoped_body);
+        }
+    }
+    return expanded_body;
 }
@@ -35,19 +35,29 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Body.h"
 #include "Exception.h"
 
+#include <functional>
+
 class RepeatBody: public BodyElement {
 public:
-    RepeatBody(Symbol variable, std::optional<Expression> start, Expression end, Body body): variable{variable}, start{std::move(start)}, end{std::move(end)}, body{std::move(body)} {}
+    RepeatBody(Symbol variable, std::optional<Expression> start, Expression end, Body body): BodyElement(SizeRange(0, {})), variable{variable}, start{std::move(start)}, end{std::move(end)}, body{std::move(body)} {}
 
-    static Body create(Symbol variable, const std::optional<Expression>& start, const Expression& end, const Body& body);
+    static Body create(Symbol variable, const std::optional<Expression>& start, const Expression& end, const Body& body, const EvaluationContext* context = nullptr);
 
-    [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {throw Exception("can't clone repeat");}
+    [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {return std::make_shared<RepeatBody>(*this);}
+    void collect_objects(std::unordered_set<Object*>& objects) const override {body.collect_objects(objects);}
+    [[nodiscard]] bool depends_on_position() const override {return body.depends_on_position();}
     [[nodiscard]] bool empty() const override {return false;}
-    void encode(std::string& bytes, const Memory* memory) const override  {throw Exception("unresolved repeat");}
+    void encode(ByteSink& bytes, const Memory* memory) const override;
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext& context) const override;
     void serialize(std::ostream& stream, const std::string& prefix) const override;
 
 private:
+    // With constant bounds, a body that doesn't depend on its position is kept rolled up and only expanded when encoding.
+    [[nodiscard]] bool is_rolled() const {return (!start || start->has_value()) && end.has_value();}
+    void for_each_index(const std::function<void(const Value& index)>& function) const;
+    [[nodiscard]] SizeRange iterations_size(const EvaluationContext* context) const;
+    static Body unrolled(Symbol variable, const std::optional<Expression>& start, const Expression& end, const Body& body, const Body& scoped_body);
+
     Symbol variable;
     std::optional<Expression> start;
     Expression end;
@@ -41,8 +41,9 @@ class ScopeBody: public BodyElement {
     explicit ScopeBody(Body body_, const std::shared_ptr<Environment>& inner_environment): body(std::move(body_)), environment(inner_environment) {size_range_=body.size_range();}
 
     [[nodiscard]] std::shared_ptr<BodyElement> clone() const override {throw Exception("can't clone ScopeBody");}
+    [[nodiscard]] bool depends_on_position() const override {return body.depends_on_position();}
     [[nodiscard]] bool empty() const override {return body.empty();}
-    void encode(std::string &bytes, const Memory *memory) const override {body.encode(bytes, memory);}
+    void encode(ByteSink& bytes, const Memory *memory) const override {body.encode(bytes, memory);}
     [[nodiscard]] std::optional<Body> evaluated(const EvaluationContext &context) const override;
     void serialize(std::ostream &stream, const std::string &prefix) const override;
 
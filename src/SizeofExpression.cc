@@ -63,6 +63,7 @@ Expression SizeofExpression::create(const Location& location, const Object* obje
 
 
 std::optional<Expression> SizeofExpression::evaluated(const EvaluationContext& context) const {
+    context.result.add_used_symbol(object_name);
     if (object) {
         if (size_range != object->size_range()) {
             return create(location, object);
@@ -0,0 +1,228 @@
+/*
+Statistics.cc -- time and memory used by phases of a run
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+
+#include <sys/resource.h>
+
+Statistics Statistics::global;
+
+namespace {
+
+double milliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string json_string(const std::string& string) {
+    auto result = std::string("\"");
+    for (auto c: string) {
+        switch (c) {
+            case '"':
+            case '\\':
+                result += '\\';
+                result += c;
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    result += buffer;
+                }
+                else {
+                    result += c;
+                }
+                break;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+}
+
+Statistics::Phase::Phase(Statistics& statistics, std::string name): statistics(statistics), name(std::move(name)) {
+    if (statistics.enabled) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+Statistics::Phase::~Phase() {
+    if (statistics.enabled) {
+        statistics.add_phase(name, std::chrono::steady_clock::now() - start);
+    }
+}
+
+void Statistics::Phase::next(std::string next_name) {
+    if (statistics.enabled) {
+        auto now = std::chrono::steady_clock::now();
+        statistics.add_phase(name, now - start);
+        start = now;
+    }
+    name = std::move(next_name);
+}
+
+void Statistics::add_phase(const std::string& name, std::chrono::steady_clock::duration duration) {
+    auto lock = std::lock_guard(mutex);
+    auto it = std::ranges::find(phases, name, &PhaseTime::name);
+    if (it == phases.end()) {
+        it = phases.insert(it, PhaseTime{name});
+    }
+    it->duration += duration;
+    it->count += 1;
+    it->peak_memory = peak_memory();
+}
+
+void Statistics::add_file(const std::string& name, std::chrono::steady_clock::duration duration) {
+    if (!enabled) {
+        return;
+    }
+    auto lock = std::lock_guard(mutex);
+    files.emplace_back(name, duration);
+}
+
+void Statistics::add_object(const std::string& name, size_t evaluations, uint64_t size) {
+    if (!enabled) {
+        return;
+    }
+    auto lock = std::lock_guard(mutex);
+    objects.emplace_back(name, evaluations, size);
+}
+
+void Statistics::write(std::ostream& stream) const {
+    auto lock = std::lock_guard(mutex);
+    auto flags = stream.flags();
+
+    stream << std::left << std::setw(20) << "phase" << std::right << std::setw(8) << "count" << std::setw(14) << "time" << std::setw(14) << "peak memory" << std::endl;
+    auto total = std::chrono::steady_clock::duration{};
+    for (const auto& phase: phases) {
+        stream << std::left << std::setw(20) << phase.name << std::right << std::setw(8) << phase.count << std::setw(12) << std::fixed << std::setprecision(3) << milliseconds(phase.duration) << "ms" << std::setw(11) << phase.peak_memory / 1024 << "KiB" << std::endl;
+        total += phase.duration;
+    }
+    stream << std::left << std::setw(28) << "total" << std::right << std::setw(12) << milliseconds(total) << "ms" << std::setw(11) << peak_memory() / 1024 << "KiB" << std::endl;
+
+    if (!files.empty()) {
+        stream << std::endl << "slowest files:" << std::endl;
+        for (const auto& file: slowest_files()) {
+            stream << std::setw(12) << milliseconds(file.duration) << "ms  " << file.name << std::endl;
+        }
+    }
+
+    if (!objects.empty()) {
+        stream << std::endl << "most evaluated objects:" << std::endl;
+        for (const auto& object: most_evaluated_objects()) {
+            stream << std::setw(14) << object.evaluations << "  " << object.name << std::endl;
+        }
+        stream << std::endl << "largest objects:" << std::endl;
+        for (const auto& object: largest_objects()) {
+            stream << std::setw(14) << object.size << "  " << object.name << std::endl;
+        }
+    }
+
+    stream.flags(flags);
+}
+
+void Statistics::write_json(std::ostream& stream) const {
+    auto lock = std::lock_guard(mutex);
+    auto flags = stream.flags();
+    stream << std::fixed << std::setprecision(3);
+
+    stream << "{" << std::endl << "  \"phases\": [";
+    auto first = true;
+    for (const auto& phase: phases) {
+        stream << (first ? "" : ",") << std::endl << "    {\"name\": " << json_string(phase.name) << ", \"count\": " << phase.count << ", \"milliseconds\": " << milliseconds(phase.duration) << ", \"peak_memory\": " << phase.peak_memory << "}";
+        first = false;
+    }
+    stream << std::endl << "  ]," << std::endl;
+    stream << "  \"peak_memory\": " << peak_memory() << "," << std::endl;
+
+    stream << "  \"slowest_files\": [";
+    first = true;
+    for (const auto& file: slowest_files()) {
+        stream << (first ? "" : ",") << std::endl << "    {\"name\": " << json_string(file.name) << ", \"milliseconds\": " << milliseconds(file.duration) << "}";
+        first = false;
+    }
+    stream << std::endl << "  ]";
+
+    auto write_objects = [&stream](const char* key, const std::vector<ObjectStatistics>& list) {
+        stream << "," << std::endl << "  \"" << key << "\": [";
+        auto first_object = true;
+        for (const auto& object: list) {
+            stream << (first_object ? "" : ",") << std::endl << "    {\"name\": " << json_string(object.name) << ", \"evaluations\": " << object.evaluations << ", \"size\": " << object.size << "}";
+            first_object = false;
+        }
+        stream << std::endl << "  ]";
+    };
+    write_objects("most_evaluated_objects", most_evaluated_objects());
+    write_objects("largest_objects", largest_objects());
+    stream << std::endl << "}" << std::endl;
+
+    stream.flags(flags);
+}
+
+std::vector<Statistics::FileTime> Statistics::slowest_files() const {
+    auto result = files;
+    std::ranges::stable_sort(result, std::ranges::greater{}, &FileTime::duration);
+    result.resize(std::min(result.size(), hot_spot_count));
+    return result;
+}
+
+std::vector<Statistics::ObjectStatistics> Statistics::most_evaluated_objects() const {
+    auto result = objects;
+    std::ranges::stable_sort(result, std::ranges::greater{}, &ObjectStatistics::evaluations);
+    result.resize(std::min(result.size(), hot_spot_count));
+    return result;
+}
+
+std::vector<Statistics::ObjectStatistics> Statistics::largest_objects() const {
+    auto result = objects;
+    std::ranges::stable_sort(result, std::ranges::greater{}, &ObjectStatistics::size);
+    result.resize(std::min(result.size(), hot_spot_count));
+    return result;
+}
+
+uint64_t Statistics::peak_memory() {
+    auto usage = rusage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
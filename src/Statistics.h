@@ -0,0 +1,150 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+/*
+Statistics.h -- time and memory used by phases of a run
+
+Copyright (C) Dieter Baron
+
+The authors can be contacted at <accelerate@tpau.group>
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. The names of the authors may not be used to endorse or promote
+  products derived from this software without specific prior
+  written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE AUTHORS "AS IS" AND ANY EXPRESS
+OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Records wall time and peak memory use of the phases of a run, and hot spots within them, for `--stats`.
+ *
+ * Nothing is recorded unless `enabled` is set.
+ */
+class Statistics {
+  public:
+    /// @brief Times a phase from construction to destruction.
+    class Phase {
+      public:
+        /**
+         * Start timing a phase.
+         *
+         * @param statistics The statistics to record the phase in.
+         * @param name The name of the phase. Phases with the same name are added up.
+         */
+        Phase(Statistics& statistics, std::string name);
+        ~Phase();
+
+        /**
+         * End the current phase and start timing the next one.
+         *
+         * @param next_name The name of the next phase.
+         */
+        void next(std::string next_name);
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+      private:
+        Statistics& statistics;
+        std::string name;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * Record the time it took to assemble a file.
+     *
+     * May be called from multiple threads.
+     *
+     * @param name The name of the file.
+     * @param duration The time taken.
+     */
+    void add_file(const std::string& name, std::chrono::steady_clock::duration duration);
+
+    /**
+     * Record an object of the linked program.
+     *
+     * @param name The name of the object.
+     * @param evaluations The number of times the object was evaluated.
+     * @param size The size of the object in bytes.
+     */
+    void add_object(const std::string& name, size_t evaluations, uint64_t size);
+
+    /**
+     * Write a human readable report.
+     *
+     * @param stream The stream to write to.
+     */
+    void write(std::ostream& stream) const;
+
+    /**
+     * Write the report as JSON.
+     *
+     * @param stream The stream to write to.
+     */
+    void write_json(std::ostream& stream) const;
+
+    /// @brief Whether statistics are recorded.
+    bool enabled = false;
+    /// @brief Number of hot spots listed per category.
+    size_t hot_spot_count = 10;
+
+    static Statistics global;
+
+  private:
+    class PhaseTime {
+      public:
+        std::string name;
+        std::chrono::steady_clock::duration duration{};
+        size_t count = 0;
+        uint64_t peak_memory = 0;
+    };
+
+    class FileTime {
+      public:
+        std::string name;
+        std::chrono::steady_clock::duration duration{};
+    };
+
+    class ObjectStatistics {
+      public:
+        std::string name;
+        size_t evaluations = 0;
+        uint64_t size = 0;
+    };
+
+    void add_phase(const std::string& name, std::chrono::steady_clock::duration duration);
+    [[nodiscard]] std::vector<FileTime> slowest_files() const;
+    [[nodiscard]] std::vector<ObjectStatistics> most_evaluated_objects() const;
+    [[nodiscard]] std::vector<ObjectStatistics> largest_objects() const;
+    [[nodiscard]] static uint64_t peak_memory();
+
+    std::vector<PhaseTime> phases; // In order of first occurrence.
+    std::vector<FileTime> files;
+    std::vector<ObjectStatistics> objects;
+    mutable std::mutex mutex; // Files are assembled by multiple threads.
+};
+
+#endif // STATISTICS_H
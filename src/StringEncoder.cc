@@ -35,7 +35,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StringEncoding.h"
 #include "Target.h"
 
-void StringEncoder::encode(std::string& bytes, const Value& value) const {
+void StringEncoder::encode(ByteSink& bytes, const Value& value) const {
     string_encoding->encode(bytes, value, size);
 }
 
@@ -44,7 +44,7 @@ public:
     StringEncoder() = default;
     explicit StringEncoder(const StringEncoding* string_encoding, std::optional<size_t> size = {}): string_encoding{string_encoding}, size{size} {}
 
-    void encode(std::string& bytes, const Value& value) const override;
+    void encode(ByteSink& bytes, const Value& value) const override;
     [[nodiscard]] size_t encoded_size(const Value& value) const override;
     [[nodiscard]] bool fits(const Value& value) const override;
     [[nodiscard]] bool is_natural_encoder(const Value& value) const override;
@@ -140,7 +140,7 @@ std::string StringEncoding::UTF8::encode(char32_t codepoint) {
 }
 #endif
 
-size_t StringEncoding::encode(std::string* bytes, const std::string& string) const {
+size_t StringEncoding::encode(ByteSink* bytes, const std::string& string) const {
     auto codepoints = UTF8::decode(string);
     auto length = size_t{0};
 
@@ -159,7 +159,7 @@ size_t StringEncoding::encode(std::string* bytes, const std::string& string) con
             }
             length += 1;
             if (bytes) {
-                *bytes += static_cast<char>(it->second);
+                bytes->append(static_cast<char>(it->second));
             }
             i = end + named_close.size();
         }
@@ -168,7 +168,7 @@ size_t StringEncoding::encode(std::string* bytes, const std::string& string) con
             if (auto byte = encode(codepoint)) {
                 length += 1;
                 if (bytes) {
-                    *bytes += static_cast<char>(*byte);
+                    bytes->append(static_cast<char>(*byte));
                 }
             }
             else {
@@ -533,7 +533,7 @@ size_t StringEncoding::encoded_size(const Value& value) const {
     return encoded_size(value.string_value());
 }
 
-void StringEncoding::encode(std::string& bytes, const Value& value, std::optional<size_t> size) const {
+void StringEncoding::encode(ByteSink& bytes, const Value& value, std::optional<size_t> size) const {
     auto string = value.string_value();
     if (size) {
         if (string.size() < *size) {
@@ -35,6 +35,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <unordered_map>
 
+#include "ByteSink.h"
 #include "ParsedValue.h"
 #include "Symbol.h"
 
@@ -47,8 +48,8 @@ class StringEncoding {
 
     [[nodiscard]] size_t encoded_size(const std::string& string) const {return encode(nullptr, string);}
     [[nodiscard]] size_t encoded_size(const Value& value) const;
-    void encode(std::string& bytes, const std::string& string) const {(void)encode(&bytes, string);}
-    void encode(std::string& bytes, const Value& value, std::optional<size_t> size = {}) const;
+    void encode(ByteSink& bytes, const std::string& string) const {(void)encode(&bytes, string);}
+    void encode(ByteSink& bytes, const Value& value, std::optional<size_t> size = {}) const;
 
     void serialize(std::ostream& stream) const;
 
@@ -70,7 +71,7 @@ class StringEncoding {
         uint8_t length;
     };
 
-    size_t encode(std::string* bytes, const std::string& string) const;
+    size_t encode(ByteSink* bytes, const std::string& string) const;
     [[nodiscard]] std::optional<uint8_t> encode(char32_t codepoint) const;
 
     void add_range(const std::shared_ptr<ParsedValue>& range);
@@ -31,15 +31,17 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Symbol.h"
 
+#include <mutex>
+
 Symbol::Table* Symbol::global = nullptr;
-const std::string Symbol::empty_string{};
+constinit const Symbol::Entry Symbol::empty_entry{};
 
-Symbol::Symbol(const std::string &name) {
+Symbol::Symbol(std::string_view name) {
     init_global();
     id = global->intern(name);
 }
 
-Symbol& Symbol::operator=(const std::string& name) {
+Symbol& Symbol::operator=(std::string_view name) {
     *this = Symbol(name);
     return *this;
 }
@@ -51,22 +53,41 @@ std::ostream& operator<<(std::ostream& stream, const Symbol& symbol) {
 }
 
 void Symbol::init_global() {
-    if (!global) {
-        global = new Symbol::Table();
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {global = new Symbol::Table();});
+}
+
+Symbol::Entry::Entry(std::string_view string_, size_t hash): string(string_), hash(hash) {
+    for (size_t index = 0; index < sizeof(order_prefix); index++) {
+        order_prefix <<= 8;
+        if (index < string.size()) {
+            order_prefix |= static_cast<unsigned char>(string[index]);
+        }
     }
 }
 
-const std::string* Symbol::Table::intern(const std::string& string) {
+const Symbol::Entry* Symbol::Table::intern(std::string_view string) {
     if (string.empty()) {
-        return &empty_string;
+        return &empty_entry;
     }
-    auto it = symbols.find(&string);
-    if (it == symbols.end()) {
-        auto interned_string = std::make_unique<std::string>(string);
-        auto [new_it, _] = symbols.insert({interned_string.get(), std::move(interned_string)});
-        return new_it->first;
+
+    auto key = Key{string, std::hash<std::string_view>{}(string)};
+    auto& shard = shards[key.hash % shard_count];
+    {
+        auto lock = std::shared_lock(shard.mutex);
+        auto it = shard.symbols.find(key);
+        if (it != shard.symbols.end()) {
+            return it->second;
+        }
     }
-    else {
-        return it->second.get();
+
+    auto lock = std::unique_lock(shard.mutex);
+    // Another thread may have added it in the meantime.
+    auto it = shard.symbols.find(key);
+    if (it == shard.symbols.end()) {
+        const auto& entry = shard.entries.emplace_back(string, key.hash);
+        key.string = entry.string;
+        it = shard.symbols.insert({key, &entry}).first;
     }
+    return it->second;
 }
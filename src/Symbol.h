@@ -32,27 +32,14 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef SYMBOL_H
 #define SYMBOL_H
 
-#include <memory>
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <ostream>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <vector>
-
-class SymbolTable;
-
-/// @brief Class for hashing string pointers.
-struct StringPtrHash {
-    auto operator()(const std::string* string) const noexcept {
-        return std::hash<std::string>{}(*string);
-    }
-};
-
-/// @brief Class for comparing string pointers.
-struct StringPtrEqual {
-    auto operator()(const std::string* a, const std::string* b) const {
-        return *a == *b;
-    }
-};
 
 /// @brief A Symbol represents a string in a way that allows comparison in constant time.
 class Symbol {
@@ -66,7 +53,7 @@ public:
      * @param name The string to create the symbol from.
      * @return The created symbol.
      */
-    explicit Symbol(const std::string& name);
+    explicit Symbol(std::string_view name);
 
     /**
      * Assign a symbol the symbol corresponding to a string.
@@ -74,28 +61,35 @@ public:
      * @param name The string to create the symbol from.
      * @return The created symbol.
      */
-    Symbol& operator=(const std::string& name);
+    Symbol& operator=(std::string_view name);
 
     /**
      * Get the string represented by the symbol.
      * 
      * @return The string represented by the symbol.
      */
-    [[nodiscard]] const std::string& str() const {return *id;}
+    [[nodiscard]] const std::string& str() const {return id->string;}
 
     /**
      * Get the C string represented by the symbol.
      * 
      * @return The C string represented by the symbol.
      */
-    [[nodiscard]] const char* c_str() const {return id->c_str();}
+    [[nodiscard]] const char* c_str() const {return id->string.c_str();}
 
     /** 
      * Check if the symbol is empty.
      * 
      * @return `true` if the symbol is empty, `false` otherwise.
      */
-    [[nodiscard]] bool empty() const {return id==&empty_string;}
+    [[nodiscard]] bool empty() const {return id==&empty_entry;}
+
+    /**
+     * Get the hash of the string represented by the symbol, computed when it was interned.
+     *
+     * @return The hash of the string.
+     */
+    [[nodiscard]] size_t hash() const {return id->hash;}
 
     /**
      * Check if two symbols are equal.
@@ -119,7 +113,7 @@ public:
      * @param other The symbol to compare with.
      * @return `true` if this symbol is less than the other symbol, `false` otherwise.
      */
-    bool operator<(const Symbol& other) const {return *id < *other.id;}
+    bool operator<(const Symbol& other) const {return compare(other) < 0;}
 
     /**
      * Check if this symbol is less than or equal to another symbol.
@@ -128,7 +122,7 @@ public:
      * @return `true` if this symbol is less than or equal to the other symbol, `false` otherwise.
      */
 
-     bool operator<=(const Symbol& other) const {return *id <= *other.id;}
+     bool operator<=(const Symbol& other) const {return compare(other) <= 0;}
     /**
      * Check if this symbol is greater than another symbol.
      * 
@@ -136,7 +130,7 @@ public:
      * @return `true` if this symbol is greater than the other symbol, `false` otherwise.
      */
 
-     bool operator>(const Symbol& other) const {return *id > *other.id;}
+     bool operator>(const Symbol& other) const {return compare(other) > 0;}
     /**
      * Check if this symbol is greater than or equal to another symbol.
      * 
@@ -144,7 +138,7 @@ public:
      * @return `true` if this symbol is greater than or equal to the other symbol, `false` otherwise.
      */
 
-     bool operator>=(const Symbol& other) const {return *id >= *other.id;}
+     bool operator>=(const Symbol& other) const {return compare(other) >= 0;}
     /**
      * Check if the symbol is valid (not empty).
      * 
@@ -153,21 +147,63 @@ public:
     operator bool() const {return !empty();} // NOLINT(*-explicit-constructor)
 
   private:
-    /// @brief A table of all symbols, used to ensure that each symbol is only stored once.
-    struct Table {
+    /// @brief An interned string.
+    struct Entry {
+        constexpr Entry() = default;
+        Entry(std::string_view string, size_t hash);
+
+        std::string string;
+        /// @brief Hash of `string`.
+        size_t hash{0};
+        /// @brief The first bytes of `string` as a big-endian number, so that symbols whose prefixes differ can be ordered without comparing strings.
+        uint64_t order_prefix{0};
+    };
+
+    /// @brief A table of all symbols, used to ensure that each symbol is only stored once. It may be used from multiple threads.
+    class Table {
       public:
-        const std::string* intern(const std::string& string);
+        const Entry* intern(std::string_view string);
 
       private:
-        /// @brief This table maps raw pointers of interned strings to unique pointers of the same strings.
-        std::unordered_map<const std::string*,std::unique_ptr<std::string>,StringPtrHash,StringPtrEqual> symbols;
+        struct Key {
+            std::string_view string; // Points into the entry's string.
+            size_t hash;
+
+            bool operator==(const Key& other) const {return hash == other.hash && string == other.string;}
+        };
+        struct KeyHash {
+            size_t operator()(const Key& key) const noexcept {return key.hash;}
+        };
+
+        /// @brief Symbols are distributed over shards by hash, so threads interning different strings rarely wait for each other.
+        struct Shard {
+            std::unordered_map<Key, const Entry*, KeyHash> symbols;
+            /// @brief Entries are only ever appended, so they stay in place. Allocated in blocks instead of one by one.
+            std::deque<Entry> entries;
+            /// @brief Protects `symbols` and `entries`. Looking up existing symbols only needs shared access.
+            std::shared_mutex mutex;
+        };
+
+        static constexpr size_t shard_count = 16;
+
+        std::array<Shard, shard_count> shards;
     };
 
+    [[nodiscard]] int compare(const Symbol& other) const {
+        if (id == other.id) {
+            return 0;
+        }
+        if (id->order_prefix != other.id->order_prefix) {
+            return id->order_prefix < other.id->order_prefix ? -1 : 1;
+        }
+        return id->string.compare(other.id->string);
+    }
+
     /// @brief Pointer to the interned string represented by the symbol.
-    const std::string* id{&empty_string};
+    const Entry* id{&empty_entry};
 
     /// @brief The empty string, used for empty symbols.
-    static const std::string empty_string;
+    static const Entry empty_entry;
 
     /// @brief Initialize the global symbol table.
     static void init_global();
@@ -184,7 +220,7 @@ template<>
 struct std::hash<Symbol>
 {
     std::size_t operator()(Symbol const& symbol) const noexcept {
-        return std::hash<const char*>{}(symbol.c_str());
+        return symbol.hash();
     }
 };
 
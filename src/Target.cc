@@ -35,7 +35,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TargetGetter.h"
 
 const Target Target::empty = Target();
-const Target* Target::current_target = &empty;
+thread_local const Target* Target::current_target = &empty;
 
 Target::Target(): object_file{std::make_shared<ObjectFile>()} {}
 
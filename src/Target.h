@@ -51,7 +51,7 @@ public:
     static const Target& get(const std::string& name) {return get(Symbol(name));}
     static void set_current_target(const Target* target) {current_target = target;}
     static const Target empty;
-    static const Target* current_target;
+    static thread_local const Target* current_target; // Each thread assembling a file has its own.
 
     [[nodiscard]] bool is_compatible_with(const Target& other) const; // this has everything from other
     [[nodiscard]] const StringEncoding* string_encoding(Symbol name) const;
@@ -68,6 +68,7 @@ public:
     std::unique_ptr<Output> output;
 
     std::string extension = "bin";
+    std::vector<Symbol> files; // Files read while parsing the definition, including those of its CPU.
 };
 
 #endif // TARGET_H
@@ -31,4 +31,20 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "TargetGetter.h"
 
-TargetGetter TargetGetter::global;
\ No newline at end of file
+#include <algorithm>
+
+#include "FileReader.h"
+
+TargetGetter TargetGetter::global;
+
+Target TargetGetter::parse(Symbol name, Symbol filename) {
+    auto recording = FileReader::Recording();
+    auto target = Assembler(nullptr, *TargetGetter::global.path, {}).parse_target(name, filename);
+    target.files = recording.files;
+    // The CPU may have been loaded before.
+    target.files.insert(target.files.end(), target.cpu->files.begin(), target.cpu->files.end());
+    std::ranges::sort(target.files);
+    const auto [first, last] = std::ranges::unique(target.files);
+    target.files.erase(first, last);
+    return target;
+}
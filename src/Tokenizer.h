@@ -33,6 +33,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TOKENIZER_H
 
 #include <optional>
+#include <vector>
 
 #include "Token.h"
 #include "TokenGroup.h"
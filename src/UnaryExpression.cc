@@ -34,6 +34,39 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "EvaluationContext.h"
 #include "Exception.h"
 
+Value UnaryExpression::evaluate(Expression::UnaryOperation operation, Value value) {
+    switch (operation) {
+        case Expression::UnaryOperation::PLUS:
+            break;
+
+        case Expression::UnaryOperation::MINUS:
+            value = -value;
+            break;
+
+        case Expression::UnaryOperation::BITWISE_NOT:
+            value = ~value; // TODO: mask to size
+            break;
+
+        case Expression::UnaryOperation::LOW_BYTE:
+            value = value & 0xff;
+            break;
+
+        case Expression::UnaryOperation::HIGH_BYTE:
+            value = (value >> 8) & 0xff;
+            break;
+
+        case Expression::UnaryOperation::BANK_BYTE:
+            value = (value >> 16) & 0xff;
+            break;
+
+        case Expression::NOT:
+            value = Value(!value);
+            break;
+    }
+
+    return value;
+}
+
 Expression UnaryExpression::create(const Location& location, Expression::UnaryOperation operation, Expression operand) {
     std::shared_ptr<BaseExpression> node;
 
@@ -41,37 +74,7 @@ Expression UnaryExpression::create(const Location& location, Expression::UnaryOp
         return operand;
     }
     else if (operand.has_value()) {
-        auto value = *operand.value();
-        switch (operation) {
-            case Expression::UnaryOperation::PLUS:
-                break;
-
-            case Expression::UnaryOperation::MINUS:
-                value = -value;
-                break;
-
-            case Expression::UnaryOperation::BITWISE_NOT:
-                value = ~value; // TODO: mask to size
-                break;
-
-            case Expression::UnaryOperation::LOW_BYTE:
-                value = value & 0xff;
-                break;
-
-            case Expression::UnaryOperation::HIGH_BYTE:
-                value = (value >> 8) & 0xff;
-                break;
-
-            case Expression::UnaryOperation::BANK_BYTE:
-                value = (value >> 16) & 0xff;
-                break;
-
-            case Expression::NOT:
-                value = Value(!value);
-                break;
-        }
-
-        return Expression(location, value);
+        return Expression(location, evaluate(operation, *operand.value()));
     }
     else {
         return Expression(std::make_shared<UnaryExpression>(location, operation, operand));
@@ -47,6 +47,15 @@ public:
      */
     UnaryExpression(const Location& location, Expression::UnaryOperation operation, Expression operand): BaseExpression(location), operation(operation), operand(std::move(operand)) {}
 
+    /**
+     * Apply a unary operation to a value.
+     *
+     * @param operation The unary operation.
+     * @param value The operand.
+     * @return The result of the operation.
+     */
+    [[nodiscard]] static Value evaluate(Expression::UnaryOperation operation, Value value);
+
     void collect_objects(std::unordered_set<Object*>& objects) const override { operand.collect_objects(objects);}
 
 protected:
@@ -58,6 +67,8 @@ protected:
 
     void serialize_sub(std::ostream& stream) const override;
 
+    friend class EncodingTemplate;
+    friend class ExpressionTemplate;
     friend Expression;
 
 private:
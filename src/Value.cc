@@ -195,9 +195,9 @@ std::string Value::type_name(Type type) {
     throw Exception("internal error: invalid value type %d", type);
 }
 
-std::string Value::binary_value() const {
+std::string_view Value::binary_value() const {
     if (is_binary()) {
-        return raw_binary_value();
+        return raw_binary_value().view();
     }
     else {
         throw Exception("can't convert value of type %s to binary", type_name().c_str());
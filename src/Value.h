@@ -37,6 +37,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ostream>
 #include <variant>
 
+#include "Blob.h"
 #include "Symbol.h"
 
 /// Class representing a value of any type.
@@ -93,7 +94,14 @@ public:
      * 
      * @param value The binary data value.
      */
-    explicit Value(const std::string& value): value{value} {}
+    explicit Value(const std::string& value): value{Blob(value)} {}
+
+    /**
+     * Create a value from binary data, sharing its storage.
+     * 
+     * @param value The binary data value.
+     */
+    explicit Value(Blob value): value{std::move(value)} {}
 
     /**
      * Create a value from a symbol.
@@ -115,7 +123,7 @@ public:
      * 
      * @return `true` if it is binary data, `false` otherwise.
      */
-    [[nodiscard]] bool is_binary() const {return value && std::holds_alternative<std::string>(*value);}
+    [[nodiscard]] bool is_binary() const {return value && std::holds_alternative<Blob>(*value);}
 
     /**
      * Check if it is a boolean value.
@@ -190,10 +198,10 @@ public:
     /**
      * Get the binary data of the value.
      * 
-     * @return The value as binary data.
+     * @return The value as binary data, valid as long as the value exists.
      * @throws Exception if the value is not binary data.
      */
-    [[nodiscard]] std::string binary_value() const;
+    [[nodiscard]] std::string_view binary_value() const;
 
     /**
      * Interpret value as a boolean.
@@ -500,7 +508,7 @@ public:
 
 private:
     /// @brief The value, or `std::nullopt` if it is void.
-    std::optional<std::variant<bool, double, int64_t, uint64_t, Symbol, std::string>> value;
+    std::optional<std::variant<bool, double, int64_t, uint64_t, Symbol, Blob>> value;
 
     /// @brief The explicitly set default size of the value, or 0 if the default size is not explicitly set.
     uint64_t explicit_default_size{0};
@@ -511,7 +519,7 @@ private:
      * @return The value as binary data.
      * @throws std::bad_variant_access if the value is not binary data.
      */
-    [[nodiscard]] auto raw_binary_value() const {return std::get<std::string>(*value);}
+    [[nodiscard]] const Blob& raw_binary_value() const {return std::get<Blob>(*value);}
 
     /**
      * Get the boolean value without conversions.
@@ -634,7 +642,7 @@ struct std::hash<Value> {
     std::size_t operator()(Value const &value) const noexcept {
         switch (value.type()) {
             case Value::BINARY:
-                return std::hash<std::string>{}(value.binary_value());
+                return std::hash<std::string_view>{}(value.binary_value());
             case Value::BOOLEAN:
                 return std::hash<bool>{}(value.boolean_value());
             case Value::FLOAT:
@@ -50,6 +50,7 @@ std::optional<Expression> VariableExpression::evaluated(const EvaluationContext&
     }
 
     if (!context.skipping(symbol)) {
+        context.result.add_used_symbol(symbol);
         if (context.type == EvaluationContext::LABELS || context.type == EvaluationContext::LABELS_2) {
             if (auto label = context.environment->get_label(symbol)) {
                 auto label_expression = Expression(location, ObjectNameExpression::create({}, nullptr), Expression::ADD, Expression({}, nullptr, symbol, *label));
@@ -58,6 +59,9 @@ std::optional<Expression> VariableExpression::evaluated(const EvaluationContext&
             }
         }
         else if (context.type != EvaluationContext::LABELS) {
+            if (auto resolved = context.lookup_resolved_variable(symbol)) {
+                return resolved;
+            }
             if (auto value = context.lookup_variable(symbol)) {
                 auto new_value = *value;
                 if (new_value.is_object()) {
@@ -65,6 +69,7 @@ std::optional<Expression> VariableExpression::evaluated(const EvaluationContext&
                 }
                 if (!context.shallow()) {
                     new_value.evaluate(context.evaluating_variable(symbol));
+                    context.resolved_variable(symbol, new_value);
                 }
                 return new_value;
             }
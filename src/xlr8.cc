@@ -29,7 +29,13 @@ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
 IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 #include "Assembler.h"
@@ -41,6 +47,7 @@ IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LibraryLinker.h"
 #include "ParseException.h"
 #include "ProgramLinker.h"
+#include "Statistics.h"
 #include "TargetGetter.h"
 #include "config.h"
 
@@ -61,8 +68,17 @@ private:
         std::shared_ptr<ObjectFile> file;
     };
 
+    class AssembledFile {
+    public:
+        std::shared_ptr<ObjectFile> file;
+        std::string diagnostics;
+    };
+
     static std::vector<Commandline::Option> options;
 
+    std::shared_ptr<ObjectFile> assemble(const std::string& file_name);
+    std::vector<std::future<AssembledFile>> assemble_parallel(const std::vector<std::string>& file_names, size_t jobs, std::vector<std::jthread>& workers);
+
     std::unique_ptr<Linker> linker;
     Path library_path;
     Path include_path;
@@ -73,11 +89,19 @@ private:
 };
 
 std::vector<Commandline::Option> xlr8::options = {
+    Commandline::Option("binary-library", "create library in precompiled binary format"),
     Commandline::Option("create-library", 'a', "create library"),
     Commandline::Option("define", 'D', "name", "define NAME for use in conditional compilation"),
     Commandline::Option("include-directory", 'I', "directory", "search for sources in DIRECTORY"),
+    Commandline::Option("incremental-link", "file", "reuse addresses and encoded bytes of unchanged objects from previous link, stored in FILE; output depends on previous links"),
+    Commandline::Option("jobs", 'j', "n", "assemble source files and encode objects using up to N threads"),
     Commandline::Option("library-directory", 'L', "directory", "search for libraries in DIRECTORY"),
+    Commandline::Option("placement", "strategy", "place objects using STRATEGY (first-fit, best-fit, decreasing, search)"),
+    Commandline::Option("placement-report", "compare placement strategies"),
+    Commandline::Option("placement-time-limit", "milliseconds", "stop placement search after MILLISECONDS"),
     Commandline::Option("symbol-map", "file", "write symbol map to FILE"),
+    Commandline::Option("stats", "print time and memory used by each phase"),
+    Commandline::Option("stats-json", "file", "write time and memory used by each phase to FILE in JSON format"),
     Commandline::Option("system-directory", "directory", "search for system files in DIRECTORY"),
     Commandline::Option("target", "file", "read target definition from FILE"),
     Commandline::Option("undefine", "name", "remove definition of NAME for use in conditional compilation"),
@@ -95,11 +119,20 @@ int main(int argc, char *argv[]) {
 void xlr8::process() {
     std::optional<std::string> target_name;
     auto create_program = true;
+    auto binary_library = false;
+    auto placement_strategy = Placement::FIRST_FIT;
+    auto placement_report = false;
+    std::optional<std::chrono::milliseconds> placement_time_limit;
+    std::optional<std::string> incremental_link;
+    size_t jobs = 1;
     auto ok = true;
 
     for (const auto& option: arguments.options) {
         try {
-            if (option.name == "create-library") {
+            if (option.name == "binary-library") {
+                binary_library = true;
+            }
+            else if (option.name == "create-library") {
                 create_program = false;
             }
             else if (option.name == "define") {
@@ -108,9 +141,40 @@ void xlr8::process() {
             else if (option.name == "include-directory") {
                 include_path.append_directory(option.argument);
             }
+            else if (option.name == "jobs") {
+                char* end;
+                jobs = std::strtoul(option.argument.c_str(), &end, 10);
+                if (option.argument.empty() || *end != '\0' || jobs == 0) {
+                    throw Exception("invalid number of jobs '%s'", option.argument.c_str());
+                }
+            }
             else if (option.name == "library-directory") {
                 library_path.append_directory(option.argument);
             }
+            else if (option.name == "incremental-link") {
+                incremental_link = option.argument;
+            }
+            else if (option.name == "placement") {
+                auto strategy = Placement::strategy(option.argument);
+                if (!strategy) {
+                    throw Exception("unknown placement strategy '%s'", option.argument.c_str());
+                }
+                placement_strategy = *strategy;
+            }
+            else if (option.name == "placement-report") {
+                placement_report = true;
+            }
+            else if (option.name == "placement-time-limit") {
+                char* end;
+                auto milliseconds = std::strtoul(option.argument.c_str(), &end, 10);
+                if (option.argument.empty() || *end != '\0') {
+                    throw Exception("invalid placement time limit '%s'", option.argument.c_str());
+                }
+                placement_time_limit = std::chrono::milliseconds(milliseconds);
+            }
+            else if (option.name == "stats" || option.name == "stats-json") {
+                Statistics::global.enabled = true;
+            }
             else if (option.name == "system-directory") {
                 system_path.append_directory(option.argument);
             }
@@ -144,24 +208,61 @@ void xlr8::process() {
     CPUGetter::global.path->append_path(system_path, "cpu");
 
     if (create_program) {
-        linker = std::make_unique<ProgramLinker>();
+        auto program_linker = std::make_unique<ProgramLinker>();
+        program_linker->placement_strategy = placement_strategy;
+        program_linker->placement_report = placement_report;
+        program_linker->placement_time_limit = placement_time_limit;
+        program_linker->jobs = jobs;
+        program_linker->incremental_link = incremental_link;
+        linker = std::move(program_linker);
     }
     else {
-        linker = std::make_unique<LibraryLinker>();
+        auto library_linker = std::make_unique<LibraryLinker>();
+        library_linker->binary = binary_library;
+        linker = std::move(library_linker);
     }
 
     if (target_name) {
+        auto phase = Statistics::Phase(Statistics::global, "load target");
         linker->set_target(&Target::get(*target_name));
     }
 
+    auto sources = std::vector<std::string>();
+    for (const auto &file_name: arguments.arguments) {
+        if (std::filesystem::path(file_name).extension() == ".s") {
+            sources.emplace_back(file_name);
+        }
+    }
+    // Joined on return, before sources, which they reference, is destroyed.
+    auto workers = std::vector<std::jthread>();
+    auto assembled_files = assemble_parallel(sources, jobs, workers);
+    auto next_assembled_file = assembled_files.begin();
+
     for (const auto &file_name: arguments.arguments) {
         try {
             auto extension = std::filesystem::path(file_name).extension();
 
             if (extension == ".s") {
-                files.emplace_back(file_name, Assembler(linker->target, include_path, defines).parse_object_file(Symbol(file_name)));
+                auto phase = Statistics::Phase(Statistics::global, "assemble");
+                auto file = std::shared_ptr<ObjectFile>();
+                if (assembled_files.empty()) {
+                    file = assemble(file_name);
+                }
+                else {
+                    // Report diagnostics in the same order as when assembling sequentially.
+                    auto assembled_file = (next_assembled_file++)->get();
+                    std::cerr << assembled_file.diagnostics;
+                    file = std::move(assembled_file.file);
+                }
+                if (file) {
+                    files.emplace_back(file_name, std::move(file));
+                }
+                else {
+                    ok = false;
+                }
             }
             else if (extension == ".lib") {
+                auto phase = Statistics::Phase(Statistics::global, "load libraries");
                 Target::clear_current_target();
                 linker->add_library(LibraryGetter::global.get(file_name));
                 Target::clear_current_target();
@@ -210,28 +311,88 @@ void xlr8::process() {
             break;
     }
 
-    for (const auto& file: files) {
-        try {
-            linker->add_file(file.file);
+    {
+        auto phase = Statistics::Phase(Statistics::global, "add files");
+        for (const auto& file: files) {
+            try {
+                linker->add_file(file.file);
+            }
+            catch (Exception& ex) {
+                FileReader::global.error(ex);
+                ok = false;
+            }
         }
-        catch (Exception& ex) {
-            FileReader::global.error(ex);
-            ok = false;
+        if (!ok) {
+            throw Exception();
         }
     }
-    if (!ok) {
-        throw Exception();
-    }
 
     linker->link();
 }
 
+std::shared_ptr<ObjectFile> xlr8::assemble(const std::string& file_name) {
+    auto start = std::chrono::steady_clock::now();
+    try {
+        auto file = Assembler(linker->target, include_path, defines).parse_object_file(Symbol(file_name));
+        Statistics::global.add_file(file_name, std::chrono::steady_clock::now() - start);
+        return file;
+    }
+    catch (Exception& ex) {
+        FileReader::global.error(ex, Location(file_name));
+        return {};
+    }
+}
+
+std::vector<std::future<xlr8::AssembledFile>> xlr8::assemble_parallel(const std::vector<std::string>& file_names, size_t jobs, std::vector<std::jthread>& workers) {
+    if (jobs <= 1 || file_names.size() <= 1) {
+        return {};
+    }
+
+    auto results = std::make_shared<std::vector<std::promise<AssembledFile>>>(file_names.size());
+    auto futures = std::vector<std::future<AssembledFile>>();
+    for (auto& result: *results) {
+        futures.emplace_back(result.get_future());
+    }
+
+    // Files are handed out in order, so the ones needed first are done first.
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+    for (size_t i = 0; i < std::min(jobs, file_names.size()); i++) {
+        workers.emplace_back([this, &file_names, results, next]() {
+            size_t index;
+            while ((index = (*next)++) < file_names.size()) {
+                try {
+                    auto diagnostics = std::ostringstream();
+                    FileReader::redirect_thread_diagnostics(&diagnostics);
+                    auto file = assemble(file_names[index]);
+                    FileReader::redirect_thread_diagnostics(nullptr);
+                    (*results)[index].set_value(AssembledFile{std::move(file), diagnostics.str()});
+                }
+                catch (...) {
+                    FileReader::redirect_thread_diagnostics(nullptr);
+                    (*results)[index].set_exception(std::current_exception());
+                }
+            }
+        });
+    }
+
+    return futures;
+}
+
 void xlr8::create_output() {
     linker->output(output_file.value());
 
     if (auto program_linker = linker->as_program_linker()) {
         if (auto map_file = arguments.find_last("symbol-map")) {
+            auto phase = Statistics::Phase(Statistics::global, "symbol map");
             program_linker->output_symbol_map(*map_file);
         }
     }
+
+    if (arguments.find_first("stats")) {
+        Statistics::global.write(std::cout);
+    }
+    if (auto stats_file = arguments.find_last("stats-json")) {
+        auto stream = std::ofstream(*stats_file);
+        Statistics::global.write_json(stream);
+    }
 }